@@ -3,6 +3,7 @@
 #include <curl/curl.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <dotenv/dotenv.hpp>
 #include <fstream>
 #include <iostream>
@@ -27,21 +28,28 @@ namespace AOC {
         return size * nmemb;
     }
 
-    std::string fetchRawInput(const int year, const int day) {
+    std::string baseUrl() {
+        const char* url = std::getenv("AOC_BASE_URL");
+        return url ? url : "https://adventofcode.com";
+    }
+
+    std::string sessionCookie() {
         const auto sessionOpt = loadAOCSession("../.env");
         if (!sessionOpt) {
             throw std::runtime_error("AOC_SESSION not found in .env");
         }
-        const std::string& session = *sessionOpt;
+        return "session=" + *sessionOpt;
+    }
 
+    std::string fetchRawInput(const int year, const int day) {
         const std::string url =
-            std::format("https://adventofcode.com/{}/day/{}/input", year, day);
+            std::format("{}/{}/day/{}/input", baseUrl(), year, day);
 
         CURL* curl = curl_easy_init();
         if (!curl) throw std::runtime_error("Failed to initialize curl.");
 
         std::string response;
-        const std::string cookieHeader = "session=" + session;
+        const std::string cookieHeader = sessionCookie();
 
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_COOKIE, cookieHeader.c_str());
@@ -60,8 +68,11 @@ namespace AOC {
 
     std::vector<std::string> fetchAOCInputVector(const int year,
                                                  const int day) {
-        const std::string rawInput = fetchRawInput(year, day);
-        std::istringstream iss(rawInput);
+        return splitLines(fetchRawInput(year, day));
+    }
+
+    std::vector<std::string> splitLines(const std::string_view rawInput) {
+        std::istringstream iss{std::string(rawInput)};
 
         std::vector<std::string> lines;
         std::string line;
@@ -75,23 +86,39 @@ namespace AOC {
         return lines;
     }
 
-    void submitAnswer(int year, int day, int part, std::string_view answer) {
-        const auto sessionOpt = loadAOCSession("../.env");
-
-        if (!sessionOpt) {
-            throw std::runtime_error("AOC_SESSION not found in .env");
+    std::string_view verdictName(const Verdict verdict) {
+        switch (verdict) {
+            case Verdict::Correct:
+                return "correct";
+            case Verdict::Incorrect:
+                return "incorrect";
+            case Verdict::TooHigh:
+                return "too-high";
+            case Verdict::TooLow:
+                return "too-low";
+            case Verdict::TooRecent:
+                return "too-recent";
+            case Verdict::WrongLevel:
+                return "wrong-level";
+            case Verdict::TooEarly:
+                return "too-early";
+            case Verdict::Unknown:
+                break;
         }
+        return "unknown";
+    }
 
-        const std::string& session = *sessionOpt;
+    Verdict submitAnswer(int year, int day, int part,
+                         std::string_view answer) {
+        const std::string cookieHeader = sessionCookie();
 
         const std::string url =
-            std::format("https://adventofcode.com/{}/day/{}/answer", year, day);
+            std::format("{}/{}/day/{}/answer", baseUrl(), year, day);
 
         CURL* curl = curl_easy_init();
         if (!curl) throw std::runtime_error("Failed to initialize curl.");
 
         std::string response;
-        const std::string cookieHeader = "session=" + session;
 
         const std::string postFields =
             std::format("level={}&answer={}", part, answer);
@@ -118,26 +145,27 @@ namespace AOC {
         std::ranges::transform(lower, lower.begin(), ::tolower);
 
         if (lower.contains("that's the right answer")) {
-            std::println("correct");
-            return;
+            return Verdict::Correct;
         }
         if (lower.contains("that's not the right answer")) {
-            std::println("incorrect");
-            return;
+            if (lower.contains("your answer is too high")) {
+                return Verdict::TooHigh;
+            }
+            if (lower.contains("your answer is too low")) {
+                return Verdict::TooLow;
+            }
+            return Verdict::Incorrect;
         }
         if (lower.contains("you gave an answer too recently")) {
-            std::println("too-recent");
-            return;
+            return Verdict::TooRecent;
         }
         if (lower.contains("don't seem to be solving the right level")) {
-            std::println("wrong-level");
-            return;
+            return Verdict::WrongLevel;
         }
         if (lower.contains("please don't repeatedly request this endpoint")) {
-            std::println("too-early");
-            return;
+            return Verdict::TooEarly;
         }
 
-        std::println("unknown");
+        return Verdict::Unknown;
     }
 }  // namespace AOC
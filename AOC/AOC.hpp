@@ -1,9 +1,33 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace AOC {
+    // Site root for every request: $AOC_BASE_URL, so a local stand-in can
+    // replace adventofcode.com, else https://adventofcode.com.
+    std::string baseUrl();
+    // "session=<token>" from AOC_SESSION in ../.env; throws if it is unset.
+    std::string sessionCookie();
+
     std::string fetchRawInput(int year, int day);
     std::vector<std::string> fetchAOCInputVector(int year, int day);
-    void submitAnswer(int year, int day, int part, std::string_view answer);
+    std::vector<std::string> splitLines(std::string_view rawInput);
+
+    // How the site judged a submission. TooHigh and TooLow are wrong answers
+    // that came with a hint; the last four did not judge the answer at all.
+    enum class Verdict {
+        Correct,
+        Incorrect,
+        TooHigh,
+        TooLow,
+        TooRecent,
+        WrongLevel,
+        TooEarly,
+        Unknown,
+    };
+
+    // "correct", "incorrect", "too-high", ...; also the ledger spelling.
+    std::string_view verdictName(Verdict verdict);
+    Verdict submitAnswer(int year, int day, int part, std::string_view answer);
 }  // namespace AOC
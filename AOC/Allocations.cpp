@@ -0,0 +1,155 @@
+#include "Allocations.hpp"
+
+#if defined(AOC_TRACK_ALLOCATIONS)
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Every block carries a two-word header just below the returned pointer:
+// the requested size (so delete knows how many live bytes to release, even
+// unsized) and the offset back to the start of the underlying malloc block.
+
+namespace {
+    constexpr std::size_t kHeader = alignof(std::max_align_t);
+    static_assert(kHeader >= 2 * sizeof(std::size_t));
+
+    std::atomic<std::uint64_t> allocationCount{0};
+    std::atomic<std::uint64_t> allocatedBytes{0};
+    std::atomic<std::uint64_t> liveBytes{0};
+    std::atomic<std::uint64_t> peakBytes{0};
+
+    void raisePeak(const std::uint64_t live) noexcept {
+        std::uint64_t peak = peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !peakBytes.compare_exchange_weak(
+                                  peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void* allocate(const std::size_t size,
+                   const std::size_t alignment) noexcept {
+        const std::size_t offset = std::max(alignment, kHeader);
+
+        void* raw = nullptr;
+        if (alignment > alignof(std::max_align_t)) {
+            const std::size_t total =
+                (size + offset + alignment - 1) / alignment * alignment;
+            raw = std::aligned_alloc(alignment, total);
+        } else {
+            raw = std::malloc(size + offset);
+        }
+        if (!raw) return nullptr;
+
+        auto* user = static_cast<std::byte*>(raw) + offset;
+        auto* header = reinterpret_cast<std::size_t*>(user) - 2;
+        header[0] = size;
+        header[1] = offset;
+
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        raisePeak(liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+
+        return user;
+    }
+
+    void* allocateOrThrow(const std::size_t size,
+                          const std::size_t alignment) {
+        while (true) {
+            if (void* p = allocate(size, alignment)) return p;
+
+            const std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void release(void* p) noexcept {
+        if (!p) return;
+
+        const auto* header = static_cast<const std::size_t*>(p) - 2;
+        liveBytes.fetch_sub(header[0], std::memory_order_relaxed);
+        std::free(static_cast<std::byte*>(p) - header[1]);
+    }
+
+    constexpr std::size_t kDefaultAlignment = alignof(std::max_align_t);
+}  // namespace
+
+namespace AOC {
+    AllocationCounters allocationCounters() noexcept {
+        return {allocationCount.load(std::memory_order_relaxed),
+                allocatedBytes.load(std::memory_order_relaxed),
+                liveBytes.load(std::memory_order_relaxed),
+                peakBytes.load(std::memory_order_relaxed)};
+    }
+
+    void resetAllocationPeak() noexcept {
+        peakBytes.store(liveBytes.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    }
+}  // namespace AOC
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size, kDefaultAlignment);
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size, kDefaultAlignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, kDefaultAlignment);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, kDefaultAlignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { release(p); }
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+
+void operator delete(void* p, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+    release(p);
+}
+
+#endif  // AOC_TRACK_ALLOCATIONS
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+namespace AOC {
+    struct AllocationStats {
+        std::uint64_t count = 0;
+        std::uint64_t bytes = 0;
+        // Highest number of live heap bytes at any point, including
+        // allocations that were already live when measuring started.
+        std::uint64_t peakBytes = 0;
+    };
+
+#if defined(AOC_TRACK_ALLOCATIONS)
+    // Backed by the replaced global operator new/delete in Allocations.cpp,
+    // compiled in with -DAOC_TRACK_ALLOCATIONS=ON.
+    struct AllocationCounters {
+        std::uint64_t count;
+        std::uint64_t bytes;
+        std::uint64_t liveBytes;
+        std::uint64_t peakBytes;
+    };
+
+    AllocationCounters allocationCounters() noexcept;
+
+    // Lowers the recorded peak to the bytes live right now.
+    void resetAllocationPeak() noexcept;
+
+    inline constexpr bool kAllocationTracking = true;
+
+    // Measures the heap traffic from construction until stats() is called.
+    // Phases are measured one after another, not nested: each scope resets
+    // the process-wide peak.
+    class AllocationScope {
+    public:
+        AllocationScope() noexcept {
+            resetAllocationPeak();
+            start_ = allocationCounters();
+        }
+
+        [[nodiscard]] AllocationStats stats() const noexcept {
+            const auto now = allocationCounters();
+            return {now.count - start_.count, now.bytes - start_.bytes,
+                    now.peakBytes};
+        }
+
+    private:
+        AllocationCounters start_{};
+    };
+#else
+    inline constexpr bool kAllocationTracking = false;
+
+    class AllocationScope {
+    public:
+        [[nodiscard]] AllocationStats stats() const noexcept { return {}; }
+    };
+#endif
+}  // namespace AOC
@@ -0,0 +1,57 @@
+#include "Differential.hpp"
+
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+
+namespace AOC {
+    namespace {
+        template <typename T>
+        T parseNumber(const std::string_view flag,
+                      const std::string_view text) {
+            T value{};
+            const auto [end, ec] =
+                std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc{} || end != text.data() + text.size()) {
+                throw std::invalid_argument(
+                    std::format("invalid {} '{}'", flag, text));
+            }
+            return value;
+        }
+    }  // namespace
+
+    std::optional<DifferentialOptions> DifferentialOptions::fromArgs(
+        const int argc, char* argv[]) {
+        std::optional<DifferentialOptions> options;
+        std::optional<std::uint64_t> seed;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+
+            if (arg == "--differential") {
+                options.emplace();
+            } else if (arg.starts_with("--differential=")) {
+                options.emplace().iterations =
+                    parseNumber<std::size_t>("iteration count", arg.substr(15));
+            } else if (arg.starts_with("--seed=")) {
+                seed = parseNumber<std::uint64_t>("seed", arg.substr(7));
+            }
+        }
+
+        if (options) {
+            options->seed = seed ? *seed : std::random_device{}();
+        }
+        return options;
+    }
+
+    void detail::printSpeedup(const std::string_view name,
+                              const std::size_t inputs,
+                              const double referenceMs,
+                              const double optimizedMs) {
+        std::println(
+            "{}: {} inputs agree; reference {:.3f} ms, optimized {:.3f} ms, "
+            "{:.1f}x",
+            name, inputs, referenceMs, optimizedMs,
+            optimizedMs > 0 ? referenceMs / optimizedMs : 0.0);
+    }
+}  // namespace AOC
@@ -0,0 +1,164 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <functional>
+#include <optional>
+#include <print>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AOC {
+    // `--differential[=<iterations>]` switches a day from solving its input
+    // to checking its variants; `--seed=<n>` replays an earlier run.
+    struct DifferentialOptions {
+        static constexpr std::size_t kDefaultIterations = 200;
+
+        std::size_t iterations = kDefaultIterations;
+        std::uint64_t seed = 0;
+
+        // nullopt unless --differential was passed. The seed defaults to a
+        // random one, which run() prints.
+        [[nodiscard]] static std::optional<DifferentialOptions> fromArgs(
+            int argc, char* argv[]);
+    };
+
+    namespace detail {
+        void printSpeedup(std::string_view name, std::size_t inputs,
+                          double referenceMs, double optimizedMs);
+    }  // namespace detail
+
+    // A day's straightforward implementations, kept as oracles for its fast
+    // paths. Each registered part runs both variants over generated inputs
+    // of growing size (1 to kMaxSize) and compares the answers. On the
+    // first mismatch it shrinks the input as far as the mismatch persists
+    // and prints it; otherwise it prints how much faster the optimized
+    // variant was in total.
+    template <typename Input>
+    class DifferentialSuite {
+    public:
+        static constexpr std::size_t kMaxSize = 100;
+
+        using Generate = std::function<Input(std::mt19937_64&, std::size_t)>;
+        // Smaller inputs derived from one input, most aggressive first.
+        using Shrink = std::function<std::vector<Input>(const Input&)>;
+        using Describe = std::function<std::string(const Input&)>;
+        using Solve = std::function<long long(const Input&)>;
+
+        DifferentialSuite(Generate generate, Shrink shrink, Describe describe)
+            : generate_(std::move(generate)),
+              shrink_(std::move(shrink)),
+              describe_(std::move(describe)) {}
+
+        void add(std::string name, Solve reference, Solve optimized) {
+            parts_.push_back(
+                {std::move(name), std::move(reference), std::move(optimized)});
+        }
+
+        // Returns the process exit code: 1 if any part disagreed.
+        [[nodiscard]] int run(const DifferentialOptions& options) const {
+            std::println("differential run: {} inputs per part, --seed={}",
+                         options.iterations, options.seed);
+
+            bool failed = false;
+            for (const auto& part : parts_) {
+                if (!check(part, options)) failed = true;
+            }
+            return failed ? 1 : 0;
+        }
+
+    private:
+        struct Part {
+            std::string name;
+            Solve reference;
+            Solve optimized;
+        };
+
+        // An answer, or the exception a variant threw instead.
+        using Outcome = std::string;
+
+        Generate generate_;
+        Shrink shrink_;
+        Describe describe_;
+        std::vector<Part> parts_;
+
+        [[nodiscard]] static Outcome solve(const Solve& variant,
+                                           const Input& input,
+                                           double& milliseconds) {
+            const auto start = std::chrono::steady_clock::now();
+            Outcome outcome;
+            try {
+                outcome = std::to_string(variant(input));
+            } catch (const std::exception& e) {
+                outcome = std::format("threw: {}", e.what());
+            }
+            milliseconds += std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+            return outcome;
+        }
+
+        [[nodiscard]] bool check(const Part& part,
+                                 const DifferentialOptions& options) const {
+            std::mt19937_64 rng(options.seed);
+            double referenceMs = 0;
+            double optimizedMs = 0;
+
+            for (std::size_t i = 0; i < options.iterations; ++i) {
+                const std::size_t size =
+                    1 + i * (kMaxSize - 1) / std::max<std::size_t>(
+                                                 1, options.iterations - 1);
+                const Input input = generate_(rng, size);
+
+                if (solve(part.reference, input, referenceMs) !=
+                    solve(part.optimized, input, optimizedMs)) {
+                    report(part, i, minimize(part, input));
+                    return false;
+                }
+            }
+
+            detail::printSpeedup(part.name, options.iterations, referenceMs,
+                                 optimizedMs);
+            return true;
+        }
+
+        [[nodiscard]] bool differs(const Part& part,
+                                   const Input& input) const {
+            double unused = 0;
+            return solve(part.reference, input, unused) !=
+                   solve(part.optimized, input, unused);
+        }
+
+        // Greedy: take the first smaller input that still disagrees, until
+        // none does.
+        [[nodiscard]] Input minimize(const Part& part, Input input) const {
+            for (bool shrunk = true; shrunk;) {
+                shrunk = false;
+                for (auto& candidate : shrink_(input)) {
+                    if (differs(part, candidate)) {
+                        input = std::move(candidate);
+                        shrunk = true;
+                        break;
+                    }
+                }
+            }
+            return input;
+        }
+
+        void report(const Part& part, const std::size_t iteration,
+                    const Input& input) const {
+            double unused = 0;
+            std::println("{}: MISMATCH on input {}, minimized to:", part.name,
+                         iteration);
+            std::println("{}", describe_(input));
+            std::println("  reference: {}",
+                         solve(part.reference, input, unused));
+            std::println("  optimized: {}",
+                         solve(part.optimized, input, unused));
+        }
+    };
+}  // namespace AOC
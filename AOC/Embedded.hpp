@@ -0,0 +1,57 @@
+#pragma once
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// With -DAOC_EMBED_INPUT=ON, CMake writes data/<year>/<day>/input.txt (and
+// answers.txt, if recorded) into a per-executable embedded_input.hpp. A
+// solution can then parse and solve its input in constant expressions and
+// check the answers with static_assert; see days 01 and 03.
+#if __has_include("embedded_input.hpp")
+#include "embedded_input.hpp"
+#endif
+
+namespace AOC {
+    // Only digits are read; parsing stops at the first other character.
+    constexpr long long parseDigits(const std::string_view text) {
+        long long value = 0;
+        for (const char c : text) {
+            if (c < '0' || c > '9') break;
+            value = value * 10 + (c - '0');
+        }
+        return value;
+    }
+
+    // Non-empty lines, as splitLines() returns them, without copying.
+    constexpr std::vector<std::string_view> lineViews(std::string_view text) {
+        std::vector<std::string_view> lines;
+
+        while (!text.empty()) {
+            const auto end = text.find('\n');
+            const auto line = text.substr(0, end);
+            if (!line.empty()) lines.push_back(line);
+            if (end == std::string_view::npos) break;
+            text.remove_prefix(end + 1);
+        }
+
+        return lines;
+    }
+
+    // True when no answer was recorded, so a fresh input still compiles.
+    constexpr bool matchesAnswer(const std::string_view expected,
+                                 const long long value) {
+        return expected.empty() || parseDigits(expected) == value;
+    }
+
+    namespace {
+        // Internal linkage on purpose: every executable sees its own
+        // embedded input, and the AOC library none.
+        constexpr std::optional<std::string_view> embeddedInput() {
+#if defined(AOC_EMBEDDED_INPUT)
+            return embedded::kInput;
+#else
+            return std::nullopt;
+#endif
+        }
+    }  // namespace
+}  // namespace AOC
@@ -0,0 +1,119 @@
+#include "Ledger.hpp"
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+namespace AOC {
+    namespace {
+        constexpr std::array kVerdicts{
+            Verdict::Correct, Verdict::Incorrect, Verdict::TooHigh,
+            Verdict::TooLow, Verdict::TooRecent, Verdict::WrongLevel,
+            Verdict::TooEarly, Verdict::Unknown};
+
+        std::optional<Verdict> parseVerdict(const std::string_view name) {
+            for (const Verdict verdict : kVerdicts) {
+                if (verdictName(verdict) == name) return verdict;
+            }
+            return std::nullopt;
+        }
+
+        std::optional<long long> parseNumber(const std::string_view text) {
+            long long value = 0;
+            const auto [end, error] =
+                std::from_chars(text.data(), text.data() + text.size(), value);
+            if (error != std::errc() || end != text.data() + text.size()) {
+                return std::nullopt;
+            }
+            return value;
+        }
+    }  // namespace
+
+    // Rows are "unix_time,part,verdict,answer". The answer comes last and
+    // runs to the end of the line, since some puzzles answer with a
+    // comma-separated list.
+    SubmissionLedger::SubmissionLedger(std::filesystem::path path)
+        : path_(std::move(path)) {
+        std::ifstream file(path_);
+        std::string line;
+        std::getline(file, line);
+
+        while (std::getline(file, line)) {
+            const std::string_view row = line;
+            const auto first = row.find(',');
+            const auto second = row.find(',', first + 1);
+            const auto third = row.find(',', second + 1);
+            if (third == std::string_view::npos) continue;
+
+            const auto part =
+                parseNumber(row.substr(first + 1, second - first - 1));
+            const auto verdict =
+                parseVerdict(row.substr(second + 1, third - second - 1));
+            if (!part || !verdict) continue;
+
+            entries_.push_back({static_cast<int>(*part),
+                                std::string(row.substr(third + 1)),
+                                *verdict});
+        }
+    }
+
+    std::optional<Verdict> SubmissionLedger::resolve(
+        const int part, const std::string_view answer) const {
+        const auto number = parseNumber(answer);
+        std::optional<Verdict> hint;
+
+        for (const auto& entry : entries_) {
+            if (entry.part != part) continue;
+
+            switch (entry.verdict) {
+                case Verdict::Correct:
+                    return entry.answer == answer ? Verdict::Correct
+                                                  : Verdict::Incorrect;
+                case Verdict::Incorrect:
+                case Verdict::TooHigh:
+                case Verdict::TooLow:
+                    if (entry.answer == answer) return entry.verdict;
+                    break;
+                default:
+                    continue;
+            }
+
+            // A later entry may still prove the answer correct or repeat
+            // it exactly, so a bound only decides once every row is seen.
+            const auto bound = parseNumber(entry.answer);
+            if (!number || !bound) continue;
+            if (entry.verdict == Verdict::TooHigh && *number > *bound) {
+                hint = Verdict::TooHigh;
+            } else if (entry.verdict == Verdict::TooLow && *number < *bound) {
+                hint = Verdict::TooLow;
+            }
+        }
+
+        return hint;
+    }
+
+    void SubmissionLedger::record(const int part,
+                                  const std::string_view answer,
+                                  const Verdict verdict) {
+        entries_.push_back({part, std::string(answer), verdict});
+        if (answer.contains('\n')) return;
+
+        std::error_code error;
+        std::filesystem::create_directories(path_.parent_path(), error);
+        const bool fresh = !std::filesystem::exists(path_, error);
+
+        std::ofstream ledger(path_, std::ios::app);
+        if (fresh) ledger << "unix_time,part,verdict,answer\n";
+
+        const auto now = std::chrono::floor<std::chrono::seconds>(
+                             std::chrono::system_clock::now())
+                             .time_since_epoch()
+                             .count();
+        ledger << std::format("{},{},{},{}\n", now, part,
+                              verdictName(verdict), answer);
+    }
+}  // namespace AOC
@@ -0,0 +1,39 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AOC.hpp"
+
+namespace AOC {
+    // Every answer a puzzle has submitted and the site's verdict, kept as
+    // data/<year>/<day>/submissions.csv. Verdicts the ledger already
+    // settles never reach the network again; only new candidates do.
+    class SubmissionLedger {
+    public:
+        // A missing or unreadable file is an empty ledger.
+        explicit SubmissionLedger(std::filesystem::path path);
+
+        // The verdict earlier responses imply, if any: the same answer was
+        // judged before, the part was already solved by another answer, or
+        // a numeric answer lies beyond a "too high" or "too low" hint.
+        [[nodiscard]] std::optional<Verdict> resolve(
+            int part, std::string_view answer) const;
+
+        // Appends the response (best effort). Verdicts that did not judge
+        // the answer are logged too, but resolve() ignores them.
+        void record(int part, std::string_view answer, Verdict verdict);
+
+    private:
+        struct Entry {
+            int part;
+            std::string answer;
+            Verdict verdict;
+        };
+
+        std::filesystem::path path_;
+        std::vector<Entry> entries_;
+    };
+}  // namespace AOC
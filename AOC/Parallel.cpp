@@ -0,0 +1,153 @@
+#include "Parallel.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+namespace AOC {
+    namespace {
+        thread_local const ThreadPool* currentPool = nullptr;
+        thread_local std::size_t currentWorker = 0;
+
+        std::mutex poolMutex;
+        std::unique_ptr<ThreadPool> globalPool;
+
+        std::size_t defaultThreadCount() {
+            if (const char* env = std::getenv("AOC_THREADS")) {
+                return parseThreadCount(env);
+            }
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+    }  // namespace
+
+    ThreadPool::ThreadPool(const std::size_t threads) {
+        const std::size_t count = std::max<std::size_t>(1, threads);
+
+        queues_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+
+        workers_.reserve(count - 1);
+        for (std::size_t w = 1; w < count; ++w) {
+            workers_.emplace_back(
+                [this, w](std::stop_token stop) { workerLoop(stop, w); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        for (auto& worker : workers_) worker.request_stop();
+        workers_.clear();
+    }
+
+    std::size_t ThreadPool::size() const noexcept { return queues_.size(); }
+
+    std::size_t ThreadPool::queueIndex() const noexcept {
+        return currentPool == this ? currentWorker : 0;
+    }
+
+    void ThreadPool::submit(Task task) {
+        {
+            Queue& queue = *queues_[queueIndex()];
+            const std::scoped_lock lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            const std::scoped_lock lock(sleepMutex_);
+            pending_.fetch_add(1, std::memory_order_release);
+        }
+        wake_.notify_one();
+    }
+
+    bool ThreadPool::runPendingTask() { return tryRun(queueIndex()); }
+
+    bool ThreadPool::tryRun(const std::size_t self) {
+        Task task;
+
+        {
+            Queue& own = *queues_[self];
+            const std::scoped_lock lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+
+        for (std::size_t k = 1; !task && k < queues_.size(); ++k) {
+            Queue& victim = *queues_[(self + k) % queues_.size()];
+            const std::scoped_lock lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+
+        if (!task) return false;
+
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(std::stop_token stop, const std::size_t self) {
+        currentPool = this;
+        currentWorker = self;
+
+        while (!stop.stop_requested()) {
+            if (tryRun(self)) continue;
+
+            std::unique_lock lock(sleepMutex_);
+            wake_.wait(lock, stop, [this] {
+                return pending_.load(std::memory_order_acquire) != 0;
+            });
+        }
+    }
+
+    ThreadPool& threadPool() {
+        const std::scoped_lock lock(poolMutex);
+        if (!globalPool) {
+            globalPool = std::make_unique<ThreadPool>(defaultThreadCount());
+        }
+        return *globalPool;
+    }
+
+    std::size_t threadCount() { return threadPool().size(); }
+
+    void setThreadCount(const std::size_t threads) {
+        const std::scoped_lock lock(poolMutex);
+        globalPool = std::make_unique<ThreadPool>(threads);
+    }
+
+    void configureThreads(const int argc, char* argv[]) {
+        constexpr std::string_view kFlag = "--threads";
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+
+            if (arg == kFlag) {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("--threads needs a value");
+                }
+                setThreadCount(parseThreadCount(argv[++i]));
+            } else if (arg.starts_with(kFlag) && arg[kFlag.size()] == '=') {
+                setThreadCount(parseThreadCount(arg.substr(kFlag.size() + 1)));
+            }
+        }
+    }
+
+    std::size_t parseThreadCount(const std::string_view text) {
+        std::size_t threads = 0;
+        const auto [end, ec] =
+            std::from_chars(text.data(), text.data() + text.size(), threads);
+
+        if (ec != std::errc{} || end != text.data() + text.size() ||
+            threads == 0) {
+            throw std::invalid_argument(
+                std::format("invalid thread count '{}'", text));
+        }
+
+        return threads;
+    }
+}  // namespace AOC
@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace AOC {
+    // Fixed set of workers, each with its own task deque. A worker runs its
+    // newest task first and, when idle, steals the oldest task of another
+    // queue. Threads outside the pool share queue 0, and any thread that
+    // waits on a TaskGroup runs pending tasks instead of blocking, so
+    // nested parallel calls cannot deadlock.
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        // `threads` counts the calling thread, so a pool of 1 runs every
+        // task inline while waiting.
+        explicit ThreadPool(std::size_t threads);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        void submit(Task task);
+
+        // Runs one queued task on the calling thread, if there is one.
+        bool runPendingTask();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::atomic<std::size_t> pending_{0};
+        std::mutex sleepMutex_;
+        std::condition_variable_any wake_;
+        std::vector<std::jthread> workers_;
+
+        [[nodiscard]] std::size_t queueIndex() const noexcept;
+        bool tryRun(std::size_t self);
+        void workerLoop(std::stop_token stop, std::size_t self);
+    };
+
+    // The process-wide pool. Its size comes from setThreadCount, or else
+    // from AOC_THREADS, or else from std::thread::hardware_concurrency.
+    ThreadPool& threadPool();
+    std::size_t threadCount();
+
+    // Replaces the process-wide pool; must not race with running tasks.
+    void setThreadCount(std::size_t threads);
+
+    // Applies `--threads N` or `--threads=N` from the command line.
+    void configureThreads(int argc, char* argv[]);
+
+    std::size_t parseThreadCount(std::string_view text);
+
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool = threadPool()) : pool_(pool) {}
+        ~TaskGroup() { drain(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template <typename Fn>
+        void run(Fn&& fn) {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_.submit([this, fn = std::forward<Fn>(fn)]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    const std::scoped_lock lock(errorMutex_);
+                    if (!error_) error_ = std::current_exception();
+                }
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        // Helps run tasks until every task of this group has finished,
+        // then rethrows the first exception any of them threw.
+        void wait() {
+            drain();
+            if (error_) std::rethrow_exception(std::exchange(error_, {}));
+        }
+
+    private:
+        ThreadPool& pool_;
+        std::atomic<std::size_t> pending_{0};
+        std::mutex errorMutex_;
+        std::exception_ptr error_;
+
+        void drain() noexcept {
+            while (pending_.load(std::memory_order_acquire) != 0) {
+                if (!pool_.runPendingTask()) std::this_thread::yield();
+            }
+        }
+    };
+
+    // Lets the chunk size follow the range length alone, never the thread
+    // count, so results are reproducible under any --threads setting.
+    inline constexpr std::size_t kAutoGrain = 0;
+
+    namespace detail {
+        inline constexpr std::size_t kAutoChunks = 256;
+        inline constexpr std::size_t kMinSortGrain = 1 << 14;
+
+        [[nodiscard]] inline std::size_t chunkSize(const std::size_t count,
+                                                   const std::size_t grain) {
+            if (grain != kAutoGrain) return grain;
+            return std::max<std::size_t>(
+                1, (count + kAutoChunks - 1) / kAutoChunks);
+        }
+    }  // namespace detail
+
+    // Calls fn(lo, hi) for consecutive chunks of [begin, end) of `grain`
+    // items each (the last may be shorter), in no particular order.
+    template <typename Fn>
+    void parallelFor(const std::size_t begin, const std::size_t end,
+                     const std::size_t grain, Fn&& fn) {
+        if (begin >= end) return;
+
+        const std::size_t chunk = detail::chunkSize(end - begin, grain);
+
+        if (end - begin <= chunk || threadCount() == 1) {
+            for (std::size_t lo = begin; lo < end; lo += chunk) {
+                fn(lo, std::min(end, lo + chunk));
+            }
+            return;
+        }
+
+        TaskGroup group;
+        for (std::size_t lo = begin; lo < end; lo += chunk) {
+            const std::size_t hi = std::min(end, lo + chunk);
+            group.run([&fn, lo, hi] { fn(lo, hi); });
+        }
+        group.wait();
+    }
+
+    // Maps each chunk of [begin, end) to a partial result and folds the
+    // partials left to right in chunk order. The chunking depends only on
+    // the range and grain, so even a non-associative combine (floating
+    // point) gives the same answer for every thread count.
+    template <typename T, typename Map, typename Combine>
+    [[nodiscard]] T parallelReduce(const std::size_t begin,
+                                   const std::size_t end,
+                                   const std::size_t grain, T identity,
+                                   Map&& map, Combine&& combine) {
+        if (begin >= end) return identity;
+
+        const std::size_t chunk = detail::chunkSize(end - begin, grain);
+        const std::size_t chunks = (end - begin + chunk - 1) / chunk;
+        std::vector<T> partials(chunks, identity);
+
+        parallelFor(0, chunks, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t c = first; c < last; ++c) {
+                const std::size_t lo = begin + c * chunk;
+                partials[c] = map(lo, std::min(end, lo + chunk));
+            }
+        });
+
+        T result = std::move(identity);
+        for (auto& partial : partials) {
+            result = combine(std::move(result), std::move(partial));
+        }
+        return result;
+    }
+
+    // Sorts fixed-size chunks in parallel, then merges neighbouring runs
+    // in rounds of doubling width.
+    template <std::random_access_iterator It, typename Compare = std::less<>>
+    void parallelSort(It first, It last, Compare comp = {},
+                      const std::size_t grain = kAutoGrain) {
+        const auto count = static_cast<std::size_t>(last - first);
+        const std::size_t chunk =
+            std::max(detail::chunkSize(count, grain), detail::kMinSortGrain);
+
+        if (count <= chunk || threadCount() == 1) {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        const auto at = [first](std::size_t i) {
+            return first + static_cast<std::iter_difference_t<It>>(i);
+        };
+
+        parallelFor(0, count, chunk, [&](std::size_t lo, std::size_t hi) {
+            std::sort(at(lo), at(hi), comp);
+        });
+
+        for (std::size_t width = chunk; width < count; width *= 2) {
+            const std::size_t pairs = (count + 2 * width - 1) / (2 * width);
+
+            parallelFor(0, pairs, 1, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t p = lo; p < hi; ++p) {
+                    const std::size_t begin = p * 2 * width;
+                    const std::size_t mid = std::min(begin + width, count);
+                    const std::size_t end = std::min(begin + 2 * width, count);
+                    if (mid < end) {
+                        std::inplace_merge(at(begin), at(mid), at(end), comp);
+                    }
+                }
+            });
+        }
+    }
+
+    // Runs every callable, possibly concurrently, and waits for all.
+    template <typename... Fns>
+    void parallelInvoke(Fns&&... fns) {
+        TaskGroup group;
+        (group.run(std::forward<Fns>(fns)), ...);
+        group.wait();
+    }
+}  // namespace AOC
@@ -0,0 +1,148 @@
+#include "PerfCounters.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#endif
+
+namespace AOC {
+    bool PerfStats::empty() const noexcept {
+        return !cycles && !instructions && !l1dMisses && !llcMisses &&
+               !branchMisses;
+    }
+
+    std::optional<double> PerfStats::ipc() const noexcept {
+        if (!cycles || !instructions || *cycles == 0) return std::nullopt;
+        return static_cast<double>(*instructions) /
+               static_cast<double>(*cycles);
+    }
+
+#if defined(__linux__)
+    namespace {
+        struct Event {
+            std::uint32_t type;
+            std::uint64_t config;
+        };
+
+        // In PerfStats field order.
+        constexpr std::array<Event, 5> kEventTypes = {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+
+        int openEvent(const Event& event) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = event.type;
+            attr.config = event.config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            return static_cast<int>(
+                syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        std::string describeFailure(const int error) {
+            std::string reason = std::strerror(error);
+            if (error == EACCES || error == EPERM) {
+                std::ifstream paranoid("/proc/sys/kernel/perf_event_paranoid");
+                if (int level = 0; paranoid >> level) {
+                    reason += std::format(" (kernel.perf_event_paranoid is {})",
+                                          level);
+                }
+            }
+            return reason;
+        }
+
+        std::optional<std::uint64_t> readEvent(const int fd) {
+            if (fd < 0) return std::nullopt;
+
+            struct {
+                std::uint64_t value;
+                std::uint64_t enabled;
+                std::uint64_t running;
+            } sample{};
+            if (read(fd, &sample, sizeof(sample)) != sizeof(sample) ||
+                sample.running == 0) {
+                return std::nullopt;
+            }
+            if (sample.running == sample.enabled) return sample.value;
+
+            return static_cast<std::uint64_t>(
+                static_cast<double>(sample.value) *
+                static_cast<double>(sample.enabled) /
+                static_cast<double>(sample.running));
+        }
+    }  // namespace
+
+    PerfCounters::PerfCounters() {
+        int firstError = 0;
+        for (std::size_t i = 0; i < kEventTypes.size(); ++i) {
+            fds_[i] = openEvent(kEventTypes[i]);
+            if (fds_[i] < 0 && firstError == 0) firstError = errno;
+        }
+        if (!available()) reason_ = describeFailure(firstError);
+    }
+
+    PerfCounters::~PerfCounters() {
+        for (const int fd : fds_) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    bool PerfCounters::available() const noexcept {
+        for (const int fd : fds_) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    void PerfCounters::start() noexcept {
+        for (const int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    PerfStats PerfCounters::stop() noexcept {
+        for (const int fd : fds_) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        return {readEvent(fds_[0]), readEvent(fds_[1]), readEvent(fds_[2]),
+                readEvent(fds_[3]), readEvent(fds_[4])};
+    }
+#else
+    PerfCounters::PerfCounters() : reason_("perf_event_open needs Linux") {
+        fds_.fill(-1);
+    }
+
+    PerfCounters::~PerfCounters() = default;
+
+    bool PerfCounters::available() const noexcept { return false; }
+
+    void PerfCounters::start() noexcept {}
+
+    PerfStats PerfCounters::stop() noexcept { return {}; }
+#endif
+
+    const std::string& PerfCounters::reason() const noexcept {
+        return reason_;
+    }
+}  // namespace AOC
@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace AOC {
+    // Hardware events counted over one phase. A field is empty when the
+    // CPU, the kernel or the permissions do not provide that event.
+    struct PerfStats {
+        std::optional<std::uint64_t> cycles;
+        std::optional<std::uint64_t> instructions;
+        std::optional<std::uint64_t> l1dMisses;
+        std::optional<std::uint64_t> llcMisses;
+        std::optional<std::uint64_t> branchMisses;
+
+        [[nodiscard]] bool empty() const noexcept;
+        // Instructions per cycle, when both were counted.
+        [[nodiscard]] std::optional<double> ipc() const noexcept;
+    };
+
+    // Per-process hardware counters via perf_event_open (Linux only). They
+    // count user-space events of the calling thread and of every thread it
+    // starts afterwards, so pool workers created later are included. When
+    // the kernel refuses, available() is false and reason() says why;
+    // stop() then returns an empty PerfStats.
+    class PerfCounters {
+    public:
+        PerfCounters();
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        [[nodiscard]] bool available() const noexcept;
+        [[nodiscard]] const std::string& reason() const noexcept;
+
+        // Zeroes and enables every counter.
+        void start() noexcept;
+        // Disables the counters and reads them, scaled up if the kernel had
+        // to multiplex them with other events.
+        [[nodiscard]] PerfStats stop() noexcept;
+
+    private:
+        static constexpr std::size_t kEvents = 5;
+
+        std::array<int, kEvents> fds_;
+        std::string reason_;
+    };
+}  // namespace AOC
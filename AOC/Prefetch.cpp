@@ -0,0 +1,162 @@
+#include "Prefetch.hpp"
+
+#include <curl/curl.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+#include "AOC.hpp"
+#include "Runner.hpp"
+
+namespace AOC {
+    namespace {
+        // Parallel HTTP/1.1 connections allowed when the server cannot
+        // multiplex, such as a plain-HTTP stand-in.
+        constexpr long kMaxHostConnections = 6;
+
+        struct Download {
+            PrefetchResult* result;
+            std::filesystem::path target;
+            std::string url;
+            std::string body;
+            std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> handle{
+                nullptr, curl_easy_cleanup};
+        };
+
+        size_t appendBody(void* contents, const size_t size,
+                          const size_t nmemb, void* userp) {
+            static_cast<std::string*>(userp)->append(
+                static_cast<char*>(contents), size * nmemb);
+            return size * nmemb;
+        }
+
+        // Written next to the target and renamed into place, so an
+        // interrupted prefetch never leaves a truncated input behind.
+        void store(const std::filesystem::path& target,
+                   const std::string& body) {
+            std::filesystem::create_directories(target.parent_path());
+
+            auto partial = target;
+            partial += ".part";
+            std::ofstream(partial, std::ios::binary) << body;
+            std::filesystem::rename(partial, target);
+        }
+
+        void finish(Download& download, const CURLcode code) {
+            PrefetchResult& result = *download.result;
+            long status = 0;
+            curl_easy_getinfo(download.handle.get(), CURLINFO_RESPONSE_CODE,
+                              &status);
+
+            if (code != CURLE_OK) {
+                result.error = curl_easy_strerror(code);
+            } else if (status != 200) {
+                result.error = std::format("HTTP {}", status);
+            } else if (download.body.empty()) {
+                result.error = "empty response";
+            } else {
+                try {
+                    store(download.target, download.body);
+                    result.status = PrefetchResult::Status::Fetched;
+                    return;
+                } catch (const std::exception& e) {
+                    result.error = e.what();
+                }
+            }
+            result.status = PrefetchResult::Status::Failed;
+        }
+    }  // namespace
+
+    std::vector<PrefetchResult> prefetch(const int year,
+                                         const std::span<const int> days) {
+        std::vector<PrefetchResult> results;
+        results.reserve(days.size());
+        for (const int day : days) {
+            const bool cached = std::filesystem::exists(
+                dataDirectory(year, day) / "input.txt");
+            results.push_back({day,
+                               cached ? PrefetchResult::Status::Cached
+                                      : PrefetchResult::Status::Failed,
+                               {}});
+        }
+
+        std::vector<std::unique_ptr<Download>> downloads;
+        for (auto& result : results) {
+            if (result.status == PrefetchResult::Status::Cached) continue;
+
+            auto download = std::make_unique<Download>();
+            download->result = &result;
+            download->target = dataDirectory(year, result.day) / "input.txt";
+            download->url = std::format("{}/{}/day/{}/input", baseUrl(), year,
+                                        result.day);
+            downloads.push_back(std::move(download));
+        }
+        if (downloads.empty()) return results;
+
+        const std::string cookieHeader = sessionCookie();
+
+        std::unique_ptr<CURLM, decltype(&curl_multi_cleanup)> multi(
+            curl_multi_init(), curl_multi_cleanup);
+        if (!multi) throw std::runtime_error("Failed to initialize curl.");
+
+        curl_multi_setopt(multi.get(), CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(multi.get(), CURLMOPT_MAX_HOST_CONNECTIONS,
+                          kMaxHostConnections);
+
+        for (const auto& download : downloads) {
+            download->handle.reset(curl_easy_init());
+            CURL* curl = download->handle.get();
+            if (!curl) throw std::runtime_error("Failed to initialize curl.");
+
+            curl_easy_setopt(curl, CURLOPT_URL, download->url.c_str());
+            curl_easy_setopt(curl, CURLOPT_COOKIE, cookieHeader.c_str());
+            curl_easy_setopt(
+                curl, CURLOPT_USERAGENT,
+                "C++/curl AdventOfCodeClient (github.com/Ayush272002)");
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+                             CURL_HTTP_VERSION_2TLS);
+            // Wait for the first connection to learn whether it multiplexes
+            // before opening more.
+            curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, appendBody);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &download->body);
+            curl_easy_setopt(curl, CURLOPT_PRIVATE, download.get());
+
+            curl_multi_add_handle(multi.get(), curl);
+        }
+
+        int running = 0;
+        do {
+            if (curl_multi_perform(multi.get(), &running) != CURLM_OK) break;
+            if (running > 0) {
+                curl_multi_poll(multi.get(), nullptr, 0, 1000, nullptr);
+            }
+
+            int queued = 0;
+            while (CURLMsg* message =
+                       curl_multi_info_read(multi.get(), &queued)) {
+                if (message->msg != CURLMSG_DONE) continue;
+
+                Download* download = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE,
+                                  &download);
+                finish(*download, message->data.result);
+                curl_multi_remove_handle(multi.get(), message->easy_handle);
+            }
+        } while (running > 0);
+
+        // Anything still attached was cut off by a multi-level error.
+        for (const auto& download : downloads) {
+            if (download->result->status == PrefetchResult::Status::Failed &&
+                download->result->error.empty()) {
+                download->result->error = "transfer did not complete";
+            }
+        }
+
+        return results;
+    }
+}  // namespace AOC
@@ -0,0 +1,22 @@
+#pragma once
+#include <span>
+#include <string>
+#include <vector>
+
+namespace AOC {
+    struct PrefetchResult {
+        enum class Status { Cached, Fetched, Failed };
+
+        int day;
+        Status status;
+        // Why a download failed; empty otherwise.
+        std::string error;
+    };
+
+    // Downloads the inputs of every listed day that is not in the input
+    // store (dataDirectory(year, day)/input.txt) yet, all at once over the
+    // curl multi interface: with HTTP/2 the requests share one multiplexed
+    // connection, so warming a new machine costs one round trip instead of
+    // one per day. A failed day does not stop the others.
+    std::vector<PrefetchResult> prefetch(int year, std::span<const int> days);
+}  // namespace AOC
@@ -0,0 +1,384 @@
+#include "Runner.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <print>
+#include <sstream>
+#include <stdexcept>
+
+#include "AOC.hpp"
+#include "Ledger.hpp"
+#include "Parallel.hpp"
+
+namespace AOC {
+    namespace {
+        constexpr double kDefaultTolerance = 0.25;
+        // Timings this close to the baseline are noise, whatever the ratio.
+        constexpr double kNoiseFloorMs = 2.0;
+
+        std::string readFile(const std::filesystem::path& path) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error(
+                    std::format("cannot read {}", path.string()));
+            }
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            return contents.str();
+        }
+
+        // "<key> <value>" per line, as used by answers.txt and baseline.txt.
+        std::map<std::string, std::string> readPairs(
+            const std::filesystem::path& path) {
+            std::map<std::string, std::string> pairs;
+            std::ifstream file(path);
+            std::string key;
+            std::string value;
+
+            while (file >> key >> value) pairs[key] = value;
+            return pairs;
+        }
+
+        double parseTolerance(const std::string_view text) {
+            std::size_t used = 0;
+            const double tolerance = std::stod(std::string(text), &used);
+            if (used != text.size() || tolerance < 0) {
+                throw std::invalid_argument(
+                    std::format("invalid tolerance '{}'", text));
+            }
+            return tolerance;
+        }
+
+        std::uint64_t parseMemoryBudget(const std::string_view text) {
+            std::size_t used = 0;
+            const double mebibytes = std::stod(std::string(text), &used);
+            if (used != text.size() || mebibytes <= 0) {
+                throw std::invalid_argument(
+                    std::format("invalid memory budget '{}'", text));
+            }
+            return static_cast<std::uint64_t>(mebibytes * 1024 * 1024);
+        }
+
+        std::string formatBytes(const std::uint64_t bytes) {
+            if (bytes < 1024) return std::format("{} B", bytes);
+            if (bytes < 1024 * 1024) {
+                return std::format("{:.1f} KiB", bytes / 1024.0);
+            }
+            return std::format("{:.1f} MiB", bytes / (1024.0 * 1024.0));
+        }
+
+        std::string formatCount(const std::uint64_t count) {
+            if (count < 10'000) return std::format("{}", count);
+            if (count < 10'000'000) return std::format("{:.1f}k", count / 1e3);
+            if (count < 10'000'000'000) {
+                return std::format("{:.1f}M", count / 1e6);
+            }
+            return std::format("{:.2f}G", count / 1e9);
+        }
+
+        // Only the events the kernel actually counted are listed.
+        std::string describeCounters(const PerfStats& counters) {
+            std::string text;
+            const auto add = [&](const std::optional<std::uint64_t> value,
+                                 const std::string_view label) {
+                if (!value) return;
+                text += std::format(" {} {},", formatCount(*value), label);
+            };
+
+            add(counters.cycles, "cycles");
+            add(counters.instructions, "instr");
+            if (const auto ipc = counters.ipc()) {
+                text += std::format(" IPC {:.2f},", *ipc);
+            }
+            add(counters.l1dMisses, "L1d miss");
+            add(counters.llcMisses, "LLC miss");
+            add(counters.branchMisses, "branch miss");
+
+            text.pop_back();
+            return text;
+        }
+    }  // namespace
+
+    std::filesystem::path dataDirectory(const int year, const int day) {
+        const char* root = std::getenv("AOC_DATA_DIR");
+        return std::filesystem::path(root ? root : "../data") /
+               std::to_string(year) / std::format("{:02}", day);
+    }
+
+    Runner::Runner(const int year, const int day, const int argc,
+                   char* argv[], const std::optional<std::string_view> embedded)
+        : year_(year),
+          day_(day),
+          tolerance_(kDefaultTolerance),
+          directory_(dataDirectory(year, day)),
+          embedded_(embedded) {
+        if (const char* env = std::getenv("AOC_TOLERANCE")) {
+            tolerance_ = parseTolerance(env);
+        }
+        if (const char* env = std::getenv("AOC_MEMORY_BUDGET")) {
+            memoryBudget_ = parseMemoryBudget(env);
+        }
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+
+            if (arg == "--check") {
+                mode_ = Mode::Check;
+            } else if (arg == "--record") {
+                mode_ = Mode::Record;
+            } else if (arg.starts_with("--tolerance=")) {
+                tolerance_ = parseTolerance(arg.substr(12));
+            } else if (arg == "--perf") {
+                if (!perf_) perf_.emplace();
+            } else if (arg == "--no-snapshots") {
+                snapshots_ = false;
+            } else if (arg.starts_with("--memory-budget=")) {
+                memoryBudget_ = parseMemoryBudget(arg.substr(16));
+            }
+        }
+
+        if (memoryBudget_ && !kAllocationTracking) {
+            std::println(
+                "warning: memory budget ignored, build with "
+                "-DAOC_TRACK_ALLOCATIONS=ON to enforce it");
+        }
+
+        if (perf_ && !perf_->available()) {
+            std::println("perf counters unavailable: {}", perf_->reason());
+            perf_.reset();
+        }
+
+        // Counters only follow threads created after they open, and
+        // --threads builds the pool right away, so it must come after them.
+        configureThreads(argc, argv);
+
+        if (mode_ == Mode::Check &&
+            ((!embedded_ &&
+              !std::filesystem::exists(directory_ / "input.txt")) ||
+             !std::filesystem::exists(directory_ / "answers.txt"))) {
+            std::println("skipped: no input.txt and answers.txt in {}",
+                         directory_.string());
+            skipped_ = true;
+        }
+    }
+
+    std::string Runner::rawInput() {
+        return phase("fetch", [this] { return loadInput(); });
+    }
+
+    // Line splitting is part of the fetch phase: its per-line strings are
+    // most of the allocations input loading makes.
+    std::vector<std::string> Runner::inputLines() {
+        return phase("fetch", [this] { return splitLines(loadInput()); });
+    }
+
+    std::string Runner::loadInput() {
+        if (embedded_) return std::string(*embedded_);
+
+        const auto cached = directory_ / "input.txt";
+        if (mode_ == Mode::Check || std::filesystem::exists(cached)) {
+            return readFile(cached);
+        }
+
+        std::string input = fetchRawInput(year_, day_);
+
+        // Caching is best effort; a read-only data directory is not an
+        // error for a plain run.
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (!error) {
+            std::ofstream(cached, std::ios::binary) << input;
+        }
+
+        return input;
+    }
+
+    std::optional<std::filesystem::path> Runner::snapshotPath(
+        const std::string_view name) const {
+        if (!snapshots_) return std::nullopt;
+        return directory_ / std::format("{}.snap", name);
+    }
+
+    void Runner::answer(const int part, const std::string_view value) {
+        answers_.emplace_back(part, std::string(value));
+
+        switch (mode_) {
+            case Mode::Run:
+                std::println("Part {} ans : {}", part, value);
+                submit(part, value);
+                break;
+            case Mode::Record:
+                std::println("Part {} ans : {}", part, value);
+                break;
+            case Mode::Check: {
+                const auto expected =
+                    readPairs(directory_ / "answers.txt");
+                const auto it = expected.find(std::to_string(part));
+
+                if (it == expected.end()) {
+                    std::println("Part {} ans : {} (no expected answer)",
+                                 part, value);
+                } else if (it->second != value) {
+                    std::println("Part {} ans : {} (FAIL, expected {})",
+                                 part, value, it->second);
+                    failed_ = true;
+                } else {
+                    std::println("Part {} ans : {} (ok)", part, value);
+                }
+                break;
+            }
+        }
+    }
+
+    void Runner::submit(const int part, const std::string_view value) {
+        SubmissionLedger ledger(directory_ / "submissions.csv");
+
+        if (const auto known = ledger.resolve(part, value)) {
+            std::println("{} (from submissions.csv)", verdictName(*known));
+            return;
+        }
+
+        const Verdict verdict = submitAnswer(year_, day_, part, value);
+        std::println("{}", verdictName(verdict));
+        ledger.record(part, value, verdict);
+    }
+
+    void Runner::record(const std::string_view name,
+                        const std::chrono::steady_clock::time_point start,
+                        const AllocationStats& allocations) {
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        timings_.push_back({std::string(name), elapsed.count(), allocations,
+                            perf_ ? perf_->stop() : PerfStats{}});
+    }
+
+    int Runner::finish() {
+        if (skipped_) return kSkipped;
+
+        switch (mode_) {
+            case Mode::Run:
+                printTimings();
+                checkMemoryBudget();
+                break;
+            case Mode::Check:
+                compareWithBaseline();
+                checkMemoryBudget();
+                appendHistory();
+                break;
+            case Mode::Record:
+                printTimings();
+                checkMemoryBudget();
+                writeReference();
+                appendHistory();
+                break;
+        }
+
+        return failed_ ? 1 : 0;
+    }
+
+    std::string Runner::describe(const Timing& timing) {
+        std::string text =
+            std::format("{}: {:.3f} ms", timing.phase, timing.milliseconds);
+        if constexpr (kAllocationTracking) {
+            const auto& [count, bytes, peak] = timing.allocations;
+            text += std::format(", {} allocs, {}, peak {}", count,
+                                formatBytes(bytes), formatBytes(peak));
+        }
+        if (!timing.counters.empty()) {
+            text += " |" + describeCounters(timing.counters);
+        }
+        return text;
+    }
+
+    void Runner::printTimings() const {
+        for (const auto& timing : timings_) {
+            std::println("{}", describe(timing));
+        }
+    }
+
+    void Runner::checkMemoryBudget() {
+        if (!memoryBudget_ || !kAllocationTracking) return;
+
+        for (const auto& timing : timings_) {
+            if (timing.allocations.peakBytes <= *memoryBudget_) continue;
+
+            std::println("{}: peak {} OVER memory budget of {}",
+                         timing.phase,
+                         formatBytes(timing.allocations.peakBytes),
+                         formatBytes(*memoryBudget_));
+            failed_ = true;
+        }
+    }
+
+    void Runner::compareWithBaseline() {
+        const auto baseline = readPairs(directory_ / "baseline.txt");
+
+        for (const auto& timing : timings_) {
+            const double ms = timing.milliseconds;
+            const auto it = baseline.find(timing.phase);
+            if (it == baseline.end()) {
+                std::println("{} (no baseline)", describe(timing));
+                continue;
+            }
+
+            const double reference = std::stod(it->second);
+            const double change =
+                reference > 0 ? (ms - reference) / reference * 100 : 0;
+            const bool slower =
+                ms > reference * (1 + tolerance_) + kNoiseFloorMs;
+
+            std::println("{} (baseline {:.3f} ms, {:+.1f}%){}",
+                         describe(timing), reference, change,
+                         slower ? " SLOWER than tolerance" : "");
+            if (slower) failed_ = true;
+        }
+    }
+
+    void Runner::writeReference() const {
+        std::filesystem::create_directories(directory_);
+
+        std::ofstream answers(directory_ / "answers.txt");
+        for (const auto& [part, value] : answers_) {
+            answers << part << ' ' << value << '\n';
+        }
+
+        std::ofstream baseline(directory_ / "baseline.txt");
+        for (const auto& [phase, ms, allocations, counters] : timings_) {
+            baseline << phase << ' ' << std::format("{:.3f}", ms) << '\n';
+        }
+
+        std::println("recorded reference in {}", directory_.string());
+    }
+
+    void Runner::appendHistory() const {
+        const auto path = directory_ / "history.csv";
+        const bool fresh = !std::filesystem::exists(path);
+
+        std::ofstream history(path, std::ios::app);
+        if (fresh) {
+            history << "unix_time,mode,threads,phase,ms,allocs,bytes,"
+                       "peak_bytes,status\n";
+        }
+
+        const auto now = std::chrono::floor<std::chrono::seconds>(
+                             std::chrono::system_clock::now())
+                             .time_since_epoch()
+                             .count();
+        const std::string_view mode =
+            mode_ == Mode::Check ? "check" : "record";
+        const std::string_view status = failed_ ? "fail" : "pass";
+
+        // Allocation columns stay empty in untracked builds rather than
+        // reading as zero.
+        for (const auto& [phase, ms, allocations, counters] : timings_) {
+            const std::string heap =
+                kAllocationTracking
+                    ? std::format("{},{},{}", allocations.count,
+                                  allocations.bytes, allocations.peakBytes)
+                    : ",,";
+            history << std::format("{},{},{},{},{:.3f},{},{}\n", now, mode,
+                                   threadCount(), phase, ms, heap, status);
+        }
+    }
+}  // namespace AOC
@@ -0,0 +1,124 @@
+#pragma once
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Allocations.hpp"
+#include "PerfCounters.hpp"
+
+namespace AOC {
+    // Local files of one puzzle: $AOC_DATA_DIR/<year>/<day>/ (default
+    // ../data, next to ../.env) holding input.txt, answers.txt,
+    // baseline.txt, history.csv and submissions.csv.
+    std::filesystem::path dataDirectory(int year, int day);
+
+    // Drives one day's solution. A plain run reads the cached input (or
+    // fetches and caches it), prints and submits the answers, skipping
+    // any whose verdict submissions.csv already settles. `--check`
+    // runs offline instead: answers must match answers.txt, every timed
+    // phase must stay within the tolerance of baseline.txt, and the run is
+    // appended to history.csv. `--record` writes the current answers and
+    // timings as the new reference. In builds with AOC_TRACK_ALLOCATIONS,
+    // each phase also reports its heap traffic, and `--memory-budget=<MiB>`
+    // fails any run whose phases peak above the budget. `--perf` adds
+    // hardware counters to each phase where the kernel allows them. An
+    // executable built with AOC_EMBED_INPUT reads the input compiled into
+    // it instead.
+    class Runner {
+    public:
+        // Exit code for a --check run that has nothing to check against;
+        // CTest reports it as skipped.
+        static constexpr int kSkipped = 77;
+
+        // `embedded` is the day's AOC::embeddedInput(). Each executable
+        // passes its own, since that function has internal linkage.
+        Runner(int year, int day, int argc, char* argv[],
+               std::optional<std::string_view> embedded);
+
+        // True for a --check run without input.txt or answers.txt; main
+        // should return kSkipped before asking for input.
+        [[nodiscard]] bool skipped() const noexcept { return skipped_; }
+
+        // Both load the input as a timed "fetch" phase.
+        [[nodiscard]] std::string rawInput();
+        [[nodiscard]] std::vector<std::string> inputLines();
+
+        // Where a day keeps the binary snapshot `name` of its parsed input
+        // (see Snapshot.hpp), or nullopt when run with --no-snapshots.
+        [[nodiscard]] std::optional<std::filesystem::path> snapshotPath(
+            std::string_view name) const;
+
+        // Times fn() as the named phase and passes its result through.
+        template <typename Fn>
+        decltype(auto) phase(const std::string_view name, Fn&& fn) {
+            const AllocationScope allocations;
+            if (perf_) perf_->start();
+            const auto start = std::chrono::steady_clock::now();
+
+            if constexpr (std::is_void_v<std::invoke_result_t<Fn&>>) {
+                std::invoke(fn);
+                record(name, start, allocations.stats());
+            } else {
+                auto result = std::invoke(fn);
+                record(name, start, allocations.stats());
+                return result;
+            }
+        }
+
+        void answer(int part, std::string_view value);
+
+        template <typename T>
+            requires(!std::convertible_to<const T&, std::string_view>)
+        void answer(const int part, const T& value) {
+            answer(part, std::string_view(std::format("{}", value)));
+        }
+
+        // Reports timings and returns the process exit code.
+        [[nodiscard]] int finish();
+
+    private:
+        enum class Mode { Run, Check, Record };
+
+        struct Timing {
+            std::string phase;
+            double milliseconds;
+            AllocationStats allocations;
+            PerfStats counters;
+        };
+
+        int year_;
+        int day_;
+        Mode mode_ = Mode::Run;
+        double tolerance_;
+        std::optional<std::uint64_t> memoryBudget_;
+        std::filesystem::path directory_;
+        std::optional<std::string_view> embedded_;
+        bool snapshots_ = true;
+        std::optional<PerfCounters> perf_;
+        std::vector<Timing> timings_;
+        std::vector<std::pair<int, std::string>> answers_;
+        bool failed_ = false;
+        bool skipped_ = false;
+
+        [[nodiscard]] std::string loadInput();
+        void submit(int part, std::string_view value);
+        void record(std::string_view name,
+                    std::chrono::steady_clock::time_point start,
+                    const AllocationStats& allocations);
+        [[nodiscard]] static std::string describe(const Timing& timing);
+        void printTimings() const;
+        void checkMemoryBudget();
+        void compareWithBaseline();
+        void writeReference() const;
+        void appendHistory() const;
+    };
+}  // namespace AOC
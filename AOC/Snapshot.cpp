@@ -0,0 +1,200 @@
+#include "Snapshot.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <utility>
+
+namespace AOC {
+    namespace {
+        constexpr char kMagic[8] = {'A', 'O', 'C', 'S', 'N', 'A', 'P', '\0'};
+        // Bumped whenever the layout below changes.
+        constexpr std::uint32_t kFormatVersion = 1;
+        constexpr std::uint32_t kByteOrder = 0x01020304;
+        constexpr std::uint64_t kArrayAlignment = 64;
+
+        struct Header {
+            char magic[8];
+            std::uint32_t formatVersion;
+            std::uint32_t byteOrder;
+            std::uint32_t version;
+            std::uint32_t arrayCount;
+            std::uint64_t inputHash;
+        };
+
+        struct TableEntry {
+            std::uint64_t offset;
+            std::uint64_t count;
+            std::uint32_t elementSize;
+            std::uint32_t alignment;
+        };
+
+        constexpr std::uint64_t alignUp(const std::uint64_t offset) {
+            return (offset + kArrayAlignment - 1) / kArrayAlignment *
+                   kArrayAlignment;
+        }
+    }  // namespace
+
+    std::uint64_t inputHash(const std::string_view input) noexcept {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        for (const char c : input) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    void SnapshotWriter::write(const std::filesystem::path& path,
+                               const std::uint32_t version,
+                               const std::uint64_t inputHash) const {
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.formatVersion = kFormatVersion;
+        header.byteOrder = kByteOrder;
+        header.version = version;
+        header.arrayCount = static_cast<std::uint32_t>(arrays_.size());
+        header.inputHash = inputHash;
+
+        std::vector<TableEntry> table;
+        std::uint64_t offset =
+            alignUp(sizeof(Header) + arrays_.size() * sizeof(TableEntry));
+        for (const auto& array : arrays_) {
+            table.push_back(
+                {offset, array.count, array.elementSize, array.alignment});
+            offset = alignUp(offset + array.bytes.size());
+        }
+
+        std::filesystem::create_directories(path.parent_path());
+        auto partial = path;
+        partial += ".part";
+
+        {
+            std::ofstream file(partial, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error(
+                    std::format("cannot write {}", partial.string()));
+            }
+
+            const auto pad = [&](const std::uint64_t to) {
+                while (static_cast<std::uint64_t>(file.tellp()) < to) {
+                    file.put('\0');
+                }
+            };
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(table.data()),
+                       static_cast<std::streamsize>(table.size() *
+                                                    sizeof(TableEntry)));
+            for (std::size_t i = 0; i < arrays_.size(); ++i) {
+                pad(table[i].offset);
+                const auto& bytes = arrays_[i].bytes;
+                file.write(reinterpret_cast<const char*>(bytes.data()),
+                           static_cast<std::streamsize>(bytes.size()));
+            }
+
+            if (!file) {
+                throw std::runtime_error(
+                    std::format("cannot write {}", partial.string()));
+            }
+        }
+
+        std::filesystem::rename(partial, path);
+    }
+
+    std::optional<Snapshot> Snapshot::open(const std::filesystem::path& path,
+                                           const std::uint32_t version,
+                                           const std::uint64_t inputHash) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return std::nullopt;
+
+        struct stat info{};
+        const bool sized = ::fstat(fd, &info) == 0 &&
+                           static_cast<std::size_t>(info.st_size) >=
+                               sizeof(Header);
+        void* base = sized ? ::mmap(nullptr, info.st_size, PROT_READ,
+                                    MAP_PRIVATE, fd, 0)
+                           : MAP_FAILED;
+        ::close(fd);
+        if (base == MAP_FAILED) return std::nullopt;
+
+        Snapshot snapshot(base, static_cast<std::size_t>(info.st_size));
+
+        const auto& header = *static_cast<const Header*>(base);
+        const std::uint64_t tableEnd =
+            sizeof(Header) +
+            std::uint64_t{header.arrayCount} * sizeof(TableEntry);
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.formatVersion != kFormatVersion ||
+            header.byteOrder != kByteOrder || header.version != version ||
+            header.inputHash != inputHash || tableEnd > snapshot.size_) {
+            return std::nullopt;
+        }
+
+        // Every array must lie inside the file, so array() never reads
+        // past the mapping.
+        const auto* table = reinterpret_cast<const TableEntry*>(
+            static_cast<const std::byte*>(base) + sizeof(Header));
+        for (std::uint32_t i = 0; i < header.arrayCount; ++i) {
+            const auto& entry = table[i];
+            if (entry.elementSize == 0 || entry.alignment == 0 ||
+                entry.offset % entry.alignment != 0 ||
+                entry.offset > snapshot.size_ ||
+                (snapshot.size_ - entry.offset) / entry.elementSize <
+                    entry.count) {
+                return std::nullopt;
+            }
+        }
+
+        return snapshot;
+    }
+
+    Snapshot::Snapshot(const void* base, const std::size_t size) noexcept
+        : base_(base), size_(size) {}
+
+    Snapshot::Snapshot(Snapshot&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    Snapshot& Snapshot::operator=(Snapshot&& other) noexcept {
+        if (this != &other) {
+            if (base_) ::munmap(const_cast<void*>(base_), size_);
+            base_ = std::exchange(other.base_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    Snapshot::~Snapshot() {
+        if (base_) ::munmap(const_cast<void*>(base_), size_);
+    }
+
+    std::size_t Snapshot::arrayCount() const noexcept {
+        return static_cast<const Header*>(base_)->arrayCount;
+    }
+
+    Snapshot::Located Snapshot::locate(const std::size_t index,
+                                       const std::size_t elementSize,
+                                       const std::size_t alignment) const {
+        if (index >= arrayCount()) {
+            throw std::runtime_error(
+                std::format("snapshot has no array {}", index));
+        }
+
+        const auto* bytes = static_cast<const std::byte*>(base_);
+        const auto& entry =
+            reinterpret_cast<const TableEntry*>(bytes + sizeof(Header))[index];
+        if (entry.elementSize != elementSize || entry.alignment != alignment) {
+            throw std::runtime_error(std::format(
+                "snapshot array {} holds {}-byte elements, not {}", index,
+                entry.elementSize, elementSize));
+        }
+
+        return {bytes + entry.offset, static_cast<std::size_t>(entry.count)};
+    }
+}  // namespace AOC
@@ -0,0 +1,183 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AOC {
+    // Element types a snapshot can hold: plain bytes that stay valid when
+    // copied into a file and mapped back by the same build.
+    template <typename T>
+    concept Snapshottable = std::is_trivially_copy_constructible_v<T> &&
+                            std::is_trivially_destructible_v<T> &&
+                            std::is_standard_layout_v<T>;
+
+    // 64-bit FNV-1a of the input text; a snapshot is only reused for the
+    // exact input it was parsed from.
+    [[nodiscard]] std::uint64_t inputHash(std::string_view input) noexcept;
+
+    // Collects flat arrays and writes them as one snapshot file:
+    //
+    //   header  magic, format and schema version, input hash, array count
+    //   table   offset, element count, element size and alignment per array
+    //   arrays  each starting on a 64-byte boundary
+    //
+    // Everything is in native byte order; the header records it.
+    class SnapshotWriter {
+    public:
+        template <Snapshottable T>
+        void add(const std::span<const T> values) {
+            const auto bytes = std::as_bytes(values);
+            arrays_.push_back({{bytes.begin(), bytes.end()},
+                               values.size(),
+                               sizeof(T),
+                               alignof(T)});
+        }
+
+        // Written next to the target and renamed into place, so readers
+        // never map a half-written file.
+        void write(const std::filesystem::path& path, std::uint32_t version,
+                   std::uint64_t inputHash) const;
+
+    private:
+        struct Array {
+            std::vector<std::byte> bytes;
+            std::uint64_t count;
+            std::uint32_t elementSize;
+            std::uint32_t alignment;
+        };
+
+        std::vector<Array> arrays_;
+    };
+
+    // A read-only mapping of a snapshot file. array<T>() views the mapped
+    // memory directly, so loading costs one mmap however large the input.
+    class Snapshot {
+    public:
+        // nullopt when the file is missing, truncated, from another format
+        // or schema version, or parsed from a different input.
+        [[nodiscard]] static std::optional<Snapshot> open(
+            const std::filesystem::path& path, std::uint32_t version,
+            std::uint64_t inputHash);
+
+        Snapshot(Snapshot&& other) noexcept;
+        Snapshot& operator=(Snapshot&& other) noexcept;
+        ~Snapshot();
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        [[nodiscard]] std::size_t arrayCount() const noexcept;
+
+        // Throws std::runtime_error if array `index` does not hold Ts.
+        template <Snapshottable T>
+        [[nodiscard]] std::span<const T> array(const std::size_t index) const {
+            const auto [data, count] = locate(index, sizeof(T), alignof(T));
+            return {static_cast<const T*>(data), count};
+        }
+
+    private:
+        struct Located {
+            const void* data;
+            std::size_t count;
+        };
+
+        Snapshot(const void* base, std::size_t size) noexcept;
+
+        [[nodiscard]] Located locate(std::size_t index,
+                                     std::size_t elementSize,
+                                     std::size_t alignment) const;
+
+        const void* base_;
+        std::size_t size_;
+    };
+
+    // The arrays a day parsed from its input: views of a mapped snapshot,
+    // or of vectors parsed on this run and owned here. The views stay valid
+    // for the object's lifetime, moves included.
+    template <Snapshottable... Ts>
+    class SnapshotArrays {
+    public:
+        using Views = std::tuple<std::span<const Ts>...>;
+
+        explicit SnapshotArrays(std::tuple<std::vector<Ts>...> parsed)
+            : owned_(std::move(parsed)),
+              views_(std::apply(
+                  [](const auto&... values) { return Views(values...); },
+                  owned_)) {}
+
+        SnapshotArrays(Snapshot mapping, const Views views)
+            : mapping_(std::move(mapping)), views_(views) {}
+
+        template <std::size_t I = 0>
+        [[nodiscard]] auto view() const noexcept {
+            return std::get<I>(views_);
+        }
+
+        [[nodiscard]] const Views& views() const noexcept { return views_; }
+
+    private:
+        std::optional<Snapshot> mapping_;
+        std::tuple<std::vector<Ts>...> owned_;
+        Views views_;
+    };
+
+    // Maps the arrays of the snapshot at `path` if it matches, and
+    // otherwise parses a tuple of fresh ones and stores them (best effort; a
+    // read-only data directory only costs the speedup). Without a path it
+    // just parses.
+    template <Snapshottable... Ts, typename Parse>
+    [[nodiscard]] SnapshotArrays<Ts...> loadOrParseArrays(
+        const std::optional<std::filesystem::path>& path,
+        const std::uint32_t version, const std::string_view input,
+        Parse&& parse) {
+        using Arrays = SnapshotArrays<Ts...>;
+        if (!path) return Arrays(parse());
+
+        const std::uint64_t hash = inputHash(input);
+        if (auto snapshot = Snapshot::open(*path, version, hash)) {
+            // A layout that changed without a version bump is re-parsed
+            // like any other stale snapshot.
+            if (snapshot->arrayCount() == sizeof...(Ts)) {
+                try {
+                    const auto views =
+                        [&]<std::size_t... I>(std::index_sequence<I...>) {
+                            return typename Arrays::Views(
+                                snapshot->array<Ts>(I)...);
+                        }(std::index_sequence_for<Ts...>{});
+                    return Arrays(std::move(*snapshot), views);
+                } catch (const std::runtime_error&) {
+                }
+            }
+        }
+
+        Arrays arrays(parse());
+        try {
+            SnapshotWriter writer;
+            std::apply([&writer](const auto... values) {
+                (writer.add(values), ...);
+            }, arrays.views());
+            writer.write(*path, version, hash);
+        } catch (const std::exception&) {
+        }
+        return arrays;
+    }
+
+    // The common case of one array per input; view() is the array.
+    template <Snapshottable T, typename Parse>
+    [[nodiscard]] SnapshotArrays<T> loadOrParse(
+        const std::optional<std::filesystem::path>& path,
+        const std::uint32_t version, const std::string_view input,
+        Parse&& parse) {
+        return loadOrParseArrays<T>(
+            path, version, input,
+            [&parse] { return std::tuple<std::vector<T>>(parse()); });
+    }
+}  // namespace AOC
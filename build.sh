@@ -6,6 +6,8 @@ set -o pipefail
 ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 BUILD_DIR="$ROOT_DIR/build"
 BUILD_TYPE="Debug"
+RUN_ARGS=()
+CMAKE_ARGS=()
 
 # Arg Parser
 COMMAND=""
@@ -16,7 +18,16 @@ for arg in "$@"; do
             BUILD_TYPE="Release"
             BUILD_DIR="$ROOT_DIR/build-release"
             ;;
-        all|run|clean|format|help)
+        --threads=*|--check|--record|--tolerance=*|--memory-budget=*|--no-snapshots|--perf|--differential|--differential=*|--seed=*)
+            RUN_ARGS+=("$arg")
+            ;;
+        --track-allocations)
+            CMAKE_ARGS+=(-DAOC_TRACK_ALLOCATIONS=ON)
+            ;;
+        --embed-input)
+            CMAKE_ARGS+=(-DAOC_EMBED_INPUT=ON)
+            ;;
+        all|run|check|prefetch|clean|format|help)
             COMMAND="$arg"
             ;;
         *)
@@ -32,12 +43,25 @@ function show_help() {
     echo "Commands:"
     echo "  all                  Configure and build everything"
     echo "  run <day/year>       Run a specific Advent of Code solution (e.g., 01/2025)"
+    echo "  check                Build and run the regression suite against data/"
+    echo "  prefetch <year>      Download every missing input of that year's solutions at once"
     echo "  clean                Remove build directory"
     echo "  format               Run clang-format on all source files"
     echo "  help                 Show this page"
     echo
     echo "Options:"
     echo "  --release            Build in Release mode (default: Debug)"
+    echo "  --threads=<n>        Worker threads for the solution (default: AOC_THREADS or all cores)"
+    echo "  --check              With run: compare against data/<year>/<day>/ instead of submitting"
+    echo "  --record             With run: store the current answers and timings as the reference"
+    echo "  --tolerance=<f>      Allowed slowdown for --check as a fraction (default: 0.25)"
+    echo "  --track-allocations  Build with per-phase allocation and peak-memory counters"
+    echo "  --memory-budget=<m>  Fail the run if any phase peaks above <m> MiB of heap"
+    echo "  --embed-input        Compile cached inputs from data/ into the binaries"
+    echo "  --no-snapshots       Always parse the input text instead of loading a snapshot"
+    echo "  --perf               Report hardware counters (cycles, IPC, cache and branch misses) per phase"
+    echo "  --differential[=<n>] Check reference against optimized variants on n generated inputs (02, 07, 08, 09)"
+    echo "  --seed=<n>           Replay a differential run"
     echo
     echo "Examples:"
     echo "  ./build.sh all"
@@ -59,7 +83,7 @@ function configure() {
     mkdir -p "$BUILD_DIR"
     cd "$BUILD_DIR"
 
-    cmake "$ROOT_DIR" -DCMAKE_BUILD_TYPE="$BUILD_TYPE"
+    cmake "$ROOT_DIR" -DCMAKE_BUILD_TYPE="$BUILD_TYPE" "${CMAKE_ARGS[@]}"
 }
 
 # Build all
@@ -90,7 +114,36 @@ function run_solution() {
     fi
     
     echo "=== Running solution: $ARG ==="
-    "$EXEC_PATH"
+    "$EXEC_PATH" "${RUN_ARGS[@]}"
+}
+
+# regression suite
+function run_checks() {
+    CMAKE_ARGS+=(-DAOC_REGRESSION_TESTS=ON)
+    build_all
+    echo "=== Running regression suite ==="
+    ctest --test-dir "$BUILD_DIR" --output-on-failure
+}
+
+# prefetch inputs
+function prefetch_inputs() {
+    build_all
+
+    if [[ -z "$ARG" ]]; then
+        echo "Error: No year specified (e.g., ./build.sh prefetch 2025)"
+        exit 1
+    fi
+
+    # One day per solution file in src/<year>/
+    DAYS=()
+    for file in "$ROOT_DIR/src/$ARG"/*.cpp; do
+        [[ -e "$file" ]] || continue
+        DAY="$(basename "$file" .cpp)"
+        DAYS+=("$((10#$DAY))")
+    done
+
+    echo "=== Prefetching inputs for $ARG ==="
+    "$BUILD_DIR/bin/prefetch" "$ARG" "${DAYS[@]}"
 }
 
 # format
@@ -108,6 +161,12 @@ case "$COMMAND" in
     run)
         run_solution
         ;;
+    check)
+        run_checks
+        ;;
+    prefetch)
+        prefetch_inputs
+        ;;
     clean)
         clean_build
         ;;
@@ -0,0 +1,36 @@
+# aoc_embed_input(<target> <data dir>)
+#
+# Compiles <data dir>/input.txt, and the answers in <data dir>/answers.txt
+# if present, into an embedded_input.hpp visible only to <target>. The
+# header is regenerated whenever either file changes.
+function(aoc_embed_input TARGET DATA_DIR)
+    set(INPUT_FILE "${DATA_DIR}/input.txt")
+    set(ANSWERS_FILE "${DATA_DIR}/answers.txt")
+    set(OUTPUT_DIR "${CMAKE_BINARY_DIR}/embedded/${TARGET}")
+
+    # Bytes as character literals, so any input survives unescaped.
+    file(READ "${INPUT_FILE}" HEX HEX)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "'\\\\x\\1'," AOC_EMBED_BYTES
+            "${HEX}")
+
+    set(AOC_EMBED_ANSWER1 "")
+    set(AOC_EMBED_ANSWER2 "")
+    if(EXISTS "${ANSWERS_FILE}")
+        file(STRINGS "${ANSWERS_FILE}" ANSWERS)
+        foreach(LINE ${ANSWERS})
+            if(LINE MATCHES "^([12]) +([0-9]+)$")
+                set(AOC_EMBED_ANSWER${CMAKE_MATCH_1} "${CMAKE_MATCH_2}")
+            endif()
+        endforeach()
+        set_property(DIRECTORY APPEND PROPERTY
+                CMAKE_CONFIGURE_DEPENDS "${ANSWERS_FILE}")
+    endif()
+
+    set(AOC_EMBED_SOURCE "${INPUT_FILE}")
+    configure_file("${PROJECT_SOURCE_DIR}/cmake/embedded_input.hpp.in"
+            "${OUTPUT_DIR}/embedded_input.hpp" @ONLY)
+    set_property(DIRECTORY APPEND PROPERTY
+            CMAKE_CONFIGURE_DEPENDS "${INPUT_FILE}")
+
+    target_include_directories(${TARGET} PRIVATE "${OUTPUT_DIR}")
+endfunction()
@@ -1,17 +1,27 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Embedded.hpp"
+#include "Runner.hpp"
 
-int part1(std::vector<std::string>& combinations) {
+constexpr int rotationDistance(const std::string_view rotation) {
+    return static_cast<int>(AOC::parseDigits(rotation.substr(1)));
+}
+
+// Constexpr over owned or borrowed lines, so an embedded input is solved
+// during compilation.
+template <typename Line>
+constexpr int part1(const std::vector<Line>& combinations) {
     int zeroCount = 0;
 
     int curr = 50;
 
-    for (std::string& s : combinations) {
+    for (const std::string_view s : combinations) {
         const char dir = s[0];
-        const int num = std::stoi(s.substr(1));
+        const int num = rotationDistance(s);
 
         const int mag = (dir == 'L') ? -num : num;
 
@@ -24,14 +34,15 @@ int part1(std::vector<std::string>& combinations) {
     return zeroCount;
 }
 
-int part2(std::vector<std::string>& combinations) {
+template <typename Line>
+constexpr int part2(const std::vector<Line>& combinations) {
     int zeroCount = 0;
 
     int curr = 50;
 
-    for (std::string& s : combinations) {
+    for (const std::string_view s : combinations) {
         const char dir = s[0];
-        const int mag = std::stoi(s.substr(1));
+        const int mag = rotationDistance(s);
         const int steps = (dir == 'R') ? 1 : -1;
 
         int k0;
@@ -55,23 +66,32 @@ int part2(std::vector<std::string>& combinations) {
     return zeroCount;
 }
 
-int main() {
-    try {
-        std::vector<std::string> input = AOC::fetchAOCInputVector(2025, 1);
+#if defined(AOC_EMBEDDED_INPUT)
+constexpr int kEmbeddedPart1 = part1(AOC::lineViews(AOC::embedded::kInput));
+constexpr int kEmbeddedPart2 = part2(AOC::lineViews(AOC::embedded::kInput));
 
-        std::string part1_ans = std::to_string(part1(input));
-        std::string part2_ans = std::to_string(part2(input));
+static_assert(AOC::matchesAnswer(AOC::embedded::kAnswer1, kEmbeddedPart1));
+static_assert(AOC::matchesAnswer(AOC::embedded::kAnswer2, kEmbeddedPart2));
+#endif
 
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
+int main(int argc, char* argv[]) {
+    try {
+        AOC::Runner runner(2025, 1, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
 
-        AOC::submitAnswer(2025, 1, 1, part1_ans);
-        AOC::submitAnswer(2025, 1, 2, part2_ans);
+#if defined(AOC_EMBEDDED_INPUT)
+        runner.answer(1, runner.phase("part1", [] { return kEmbeddedPart1; }));
+        runner.answer(2, runner.phase("part2", [] { return kEmbeddedPart2; }));
+#else
+        const std::vector<std::string> input = runner.inputLines();
 
+        runner.answer(1, runner.phase("part1", [&] { return part1(input); }));
+        runner.answer(2, runner.phase("part2", [&] { return part2(input); }));
+#endif
+
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
-}
\ No newline at end of file
+}
@@ -1,10 +1,17 @@
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Differential.hpp"
+#include "Embedded.hpp"
+#include "Parallel.hpp"
+#include "Runner.hpp"
 
 std::vector<std::pair<long long, long long> > parseRanges(
     const std::string_view input) {
@@ -55,52 +62,164 @@ bool isDoubleRepeated(const long long n) {
     return s.substr(0, half) == s.substr(half);
 }
 
-long long part1(const std::string_view input) {
-    auto ranges = parseRanges(input);
-    long long sum = 0;
+constexpr int digitCount(long long n) {
+    int digits = 1;
+    while (n >= 10) {
+        n /= 10;
+        ++digits;
+    }
+    return digits;
+}
 
-    for (auto [start, end] : ranges) {
-        for (long long n = start; n <= end; ++n) {
-            if (isDoubleRepeated(n)) {
-                sum += n;
-            }
-        }
+constexpr long long pow10(const int exponent) {
+    long long value = 1;
+    for (int i = 0; i < exponent; ++i) value *= 10;
+    return value;
+}
+
+// An L-digit number repeats an l-digit block exactly when it is a multiple
+// of 10^(L-l) + ... + 10^l + 1: the quotient is then the block, and it
+// always has l digits. This replaces the string rebuilding above, which
+// stays as the reference.
+constexpr bool isRepeatedAtLeastTwiceFast(const long long n) {
+    const int length = digitCount(n);
+
+    for (int block = 1; block <= length / 2; ++block) {
+        if (length % block != 0) continue;
+
+        long long step = 0;
+        for (int k = 0; k < length; k += block) step += pow10(k);
+        if (n % step == 0) return true;
     }
 
-    return sum;
+    return false;
 }
 
-long long part2(std::string_view input) {
-    auto ranges = parseRanges(input);
+constexpr bool isDoubleRepeatedFast(const long long n) {
+    const int length = digitCount(n);
+    return length % 2 == 0 && n % (pow10(length / 2) + 1) == 0;
+}
+
+// IDs scanned by one pool task; ranges are split into chunks this size.
+constexpr std::size_t kIdsPerTask = 1 << 14;
+
+template <typename Predicate>
+long long sumMatchingIds(
+    const std::vector<std::pair<long long, long long> >& ranges,
+    Predicate matches) {
     long long sum = 0;
 
     for (auto [start, end] : ranges) {
-        for (long long n = start; n <= end; ++n) {
-            if (isRepeatedAtLeastTwice(n)) {
-                sum += n;
-            }
-        }
+        if (end < start) continue;
+
+        const auto count = static_cast<std::size_t>(end - start) + 1;
+        sum += AOC::parallelReduce(
+            0, count, kIdsPerTask, 0LL,
+            [&](const std::size_t lo, const std::size_t hi) {
+                long long partial = 0;
+                for (auto i = lo; i < hi; ++i) {
+                    const long long n = start + static_cast<long long>(i);
+                    if (matches(n)) partial += n;
+                }
+                return partial;
+            },
+            std::plus<>{});
     }
 
     return sum;
 }
 
-int main() {
+long long part1(const std::string_view input) {
+    return sumMatchingIds(parseRanges(input), isDoubleRepeatedFast);
+}
+
+long long part2(std::string_view input) {
+    return sumMatchingIds(parseRanges(input), isRepeatedAtLeastTwiceFast);
+}
+
+using Ranges = std::vector<std::pair<long long, long long> >;
+
+// Ranges of up to 12-digit IDs, a few thousand IDs wide, so the string
+// reference stays fast enough for hundreds of inputs.
+AOC::DifferentialSuite<Ranges> differentialSuite() {
+    AOC::DifferentialSuite<Ranges> suite(
+        [](std::mt19937_64& rng, const std::size_t size) {
+            Ranges ranges(1 + size / 10);
+            for (auto& [start, end] : ranges) {
+                const int digits = std::uniform_int_distribution(1, 12)(rng);
+                start = std::uniform_int_distribution<long long>(
+                    1, pow10(digits) - 1)(rng);
+                end = start + std::uniform_int_distribution<long long>(
+                                  0, static_cast<long long>(size) * 50)(rng);
+            }
+            return ranges;
+        },
+        [](const Ranges& ranges) {
+            std::vector<Ranges> smaller;
+            for (std::size_t i = 0; i < ranges.size() && ranges.size() > 1;
+                 ++i) {
+                auto without = ranges;
+                without.erase(without.begin() + static_cast<long>(i));
+                smaller.push_back(std::move(without));
+            }
+            for (std::size_t i = 0; i < ranges.size(); ++i) {
+                const auto [start, end] = ranges[i];
+                if (start == end) continue;
+                const long long mid = start + (end - start) / 2;
+                for (const auto half : {std::pair(start, mid),
+                                        std::pair(mid + 1, end)}) {
+                    auto narrowed = ranges;
+                    narrowed[i] = half;
+                    smaller.push_back(std::move(narrowed));
+                }
+            }
+            return smaller;
+        },
+        [](const Ranges& ranges) {
+            std::string text;
+            for (const auto& [start, end] : ranges) {
+                text += std::format("{}{}-{}", text.empty() ? "" : ",", start,
+                                    end);
+            }
+            return text;
+        });
+
+    suite.add(
+        "part1",
+        [](const Ranges& r) {
+            return sumMatchingIds(r, isDoubleRepeated);
+        },
+        [](const Ranges& r) {
+            return sumMatchingIds(r, isDoubleRepeatedFast);
+        });
+    suite.add(
+        "part2",
+        [](const Ranges& r) {
+            return sumMatchingIds(r, isRepeatedAtLeastTwice);
+        },
+        [](const Ranges& r) {
+            return sumMatchingIds(r, isRepeatedAtLeastTwiceFast);
+        });
+    return suite;
+}
+
+int main(int argc, char* argv[]) {
     try {
-        const std::string input = AOC::fetchRawInput(2025, 2);
+        if (const auto options =
+                AOC::DifferentialOptions::fromArgs(argc, argv)) {
+            return differentialSuite().run(*options);
+        }
 
-        std::string part1_ans = std::to_string(part1(input));
-        std::string part2_ans = std::to_string(part2(input));
+        AOC::Runner runner(2025, 2, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
+        const std::string input = runner.rawInput();
 
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
+        runner.answer(1, runner.phase("part1", [&] { return part1(input); }));
+        runner.answer(2, runner.phase("part2", [&] { return part2(input); }));
 
-        AOC::submitAnswer(2025, 2, 1, part1_ans);
-        AOC::submitAnswer(2025, 2, 2, part2_ans);
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
 }
@@ -1,10 +1,16 @@
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <print>
+#include <string_view>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Embedded.hpp"
+#include "Parallel.hpp"
+#include "Runner.hpp"
 
-int bestForLine(const std::string_view s) {
+constexpr int bestForLine(const std::string_view s) {
     const std::size_t n = s.size();
     int best = 0;
 
@@ -26,7 +32,7 @@ int bestForLine(const std::string_view s) {
     return best;
 }
 
-std::string best12(const std::string_view s) {
+constexpr std::string best12(const std::string_view s) {
     constexpr int K = 12;
     const std::size_t n = s.size();
     const std::size_t toRemove = n - K;
@@ -48,43 +54,64 @@ std::string best12(const std::string_view s) {
     return stack.substr(0, K);
 }
 
-int part1(const std::vector<std::string>& input) {
-    int sum = 0;
-    for (const auto& line : input) {
-        sum += bestForLine(line);
+// Lines are independent, so they are summed in chunks on the pool. In a
+// constant expression, where there is no pool, they are summed in order.
+constexpr std::size_t kLinesPerTask = 64;
+
+template <typename T, typename Line, typename Value>
+constexpr T sumLines(const std::vector<Line>& input, Value value) {
+    const auto sumRange = [&](const std::size_t begin, const std::size_t end) {
+        T sum = 0;
+        for (auto i = begin; i < end; ++i) sum += value(input[i]);
+        return sum;
+    };
+
+    if consteval {
+        return sumRange(0, input.size());
     }
+    return AOC::parallelReduce(0, input.size(), kLinesPerTask, T{0},
+                               sumRange, std::plus<>{});
+}
 
-    return sum;
+template <typename Line>
+constexpr int part1(const std::vector<Line>& input) {
+    return sumLines<int>(input, bestForLine);
 }
 
-long long part2(const std::vector<std::string>& input) {
-    long long sum = 0;
+template <typename Line>
+constexpr long long part2(const std::vector<Line>& input) {
+    return sumLines<long long>(input, [](const std::string_view line) {
+        return AOC::parseDigits(best12(line));
+    });
+}
 
-    for (const auto& line : input) {
-        std::string best = best12(line);
-        sum += std::stoll(best);
-    }
+#if defined(AOC_EMBEDDED_INPUT)
+constexpr int kEmbeddedPart1 = part1(AOC::lineViews(AOC::embedded::kInput));
+constexpr long long kEmbeddedPart2 =
+    part2(AOC::lineViews(AOC::embedded::kInput));
 
-    return sum;
-}
+static_assert(AOC::matchesAnswer(AOC::embedded::kAnswer1, kEmbeddedPart1));
+static_assert(AOC::matchesAnswer(AOC::embedded::kAnswer2, kEmbeddedPart2));
+#endif
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        const std::vector<std::string> input =
-            AOC::fetchAOCInputVector(2025, 3);
+        AOC::Runner runner(2025, 3, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
 
-        std::string part1_ans = std::to_string(part1(input));
-        std::string part2_ans = std::to_string(part2(input));
+#if defined(AOC_EMBEDDED_INPUT)
+        runner.answer(1, runner.phase("part1", [] { return kEmbeddedPart1; }));
+        runner.answer(2, runner.phase("part2", [] { return kEmbeddedPart2; }));
+#else
+        const auto input = runner.inputLines();
 
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
+        runner.answer(1, runner.phase("part1", [&] { return part1(input); }));
+        runner.answer(2, runner.phase("part2", [&] { return part2(input); }));
+#endif
 
-        AOC::submitAnswer(2025, 3, 1, part1_ans);
-        AOC::submitAnswer(2025, 3, 2, part2_ans);
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
 }
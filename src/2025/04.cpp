@@ -3,6 +3,8 @@
 #include <vector>
 
 #include "AOC.hpp"
+#include "Embedded.hpp"
+#include "Runner.hpp"
 
 const std::vector<std::vector<int>> dir = {{1, 0}, {-1, 0}, {0, 1},  {0, -1},
                                            {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
@@ -58,23 +60,18 @@ int part2(std::vector<std::string>& input) {
     return ans;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        std::vector<std::string> input = AOC::fetchAOCInputVector(2025, 4);
+        AOC::Runner runner(2025, 4, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
+        std::vector<std::string> input = runner.inputLines();
 
-        std::string part1_ans = std::to_string(part1(input));
-        std::string part2_ans = std::to_string(part2(input));
-
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
-
-        AOC::submitAnswer(2025, 4, 1, part1_ans);
-        AOC::submitAnswer(2025, 4, 2, part2_ans);
+        runner.answer(1, runner.phase("part1", [&] { return part1(input); }));
+        runner.answer(2, runner.phase("part2", [&] { return part2(input); }));
 
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
-}
\ No newline at end of file
+}
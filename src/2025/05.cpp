@@ -1,12 +1,20 @@
 #include <algorithm>
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <optional>
 #include <print>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Embedded.hpp"
+#include "Runner.hpp"
+#include "Snapshot.hpp"
 
 using Range = std::pair<long long, long long>;
 
@@ -33,7 +41,23 @@ std::pair<std::vector<Range>, std::vector<long long>> parseInput(
     return {ranges, ids};
 }
 
-static std::vector<Range> mergeRanges(std::vector<Range>& ranges) {
+// Bump whenever Range or parseInput changes, so stale snapshots are ignored.
+constexpr std::uint32_t kSnapshotVersion = 1;
+
+using ParsedInput = AOC::SnapshotArrays<Range, long long>;
+
+// Maps the ranges and ids parsed by an earlier run of this exact input, or
+// parses them and leaves a snapshot for the next run.
+ParsedInput loadInput(const std::optional<std::filesystem::path>& snapshot,
+                      const std::string_view input) {
+    return AOC::loadOrParseArrays<Range, long long>(
+        snapshot, kSnapshotVersion, input,
+        [input] { return parseInput(input); });
+}
+
+// Sorts a copy, so the ranges can stay in the read-only snapshot mapping.
+static std::vector<Range> mergeRanges(const std::span<const Range> input) {
+    std::vector<Range> ranges(input.begin(), input.end());
     std::ranges::sort(ranges);
 
     std::vector<Range> merged;
@@ -64,8 +88,8 @@ static bool isFresh(long long id, const std::vector<Range>& merged) {
     return false;
 }
 
-int part1(const std::pair<std::vector<Range>, std::vector<long long>>& input) {
-    auto [ranges, ids] = input;
+int part1(const ParsedInput& input) {
+    const auto [ranges, ids] = input.views();
 
     const auto merged = mergeRanges(ranges);
 
@@ -77,10 +101,8 @@ int part1(const std::pair<std::vector<Range>, std::vector<long long>>& input) {
     return count;
 }
 
-long long part2(
-    const std::pair<std::vector<Range>, std::vector<long long>>& input) {
-    auto [ranges, _] = input;
-    auto merged = mergeRanges(ranges);
+long long part2(const ParsedInput& input) {
+    const auto merged = mergeRanges(input.view<0>());
     long long total = 0;
 
     for (auto& [l, r] : merged) {
@@ -90,24 +112,23 @@ long long part2(
     return total;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        const std::string input = AOC::fetchRawInput(2025, 5);
-        const auto parsedInput = parseInput(input);
-
-        std::string part1_ans = std::to_string(part1(parsedInput));
-        std::string part2_ans = std::to_string(part2(parsedInput));
-
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
-
-        AOC::submitAnswer(2025, 5, 1, part1_ans);
-        AOC::submitAnswer(2025, 5, 2, part2_ans);
-
+        AOC::Runner runner(2025, 5, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
+        const std::string input = runner.rawInput();
+        const auto parsedInput = runner.phase("parse", [&] {
+            return loadInput(runner.snapshotPath("parse"), input);
+        });
+
+        runner.answer(1, runner.phase("part1",
+                                      [&] { return part1(parsedInput); }));
+        runner.answer(2, runner.phase("part2",
+                                      [&] { return part2(parsedInput); }));
+
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
-}
\ No newline at end of file
+}
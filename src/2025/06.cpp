@@ -1,16 +1,29 @@
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <print>
-#include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Embedded.hpp"
+#include "Parallel.hpp"
+#include "Runner.hpp"
+#include "Snapshot.hpp"
 
 template <typename T>
 concept Numeric = std::integral<T> || std::floating_point<T>;
@@ -57,9 +70,71 @@ constexpr auto to_operation(const char c) -> std::optional<Operation> {
     }
 }
 
+template <Numeric T>
+constexpr auto to_digit(const char c) -> std::optional<T> {
+    if (c < '0' || c > '9') return std::nullopt;
+    return static_cast<T>(c - '0');
+}
+
+// Converts up to eight ASCII digits at once (SWAR). The digits are
+// right-aligned in a '0'-padded word so the first character is the most
+// significant; returns nullopt if any byte is not a digit.
+constexpr auto parse_eight_digits(const std::string_view digits)
+    -> std::optional<std::uint64_t> {
+    std::array<char, 8> chunk{};
+    chunk.fill('0');
+    std::ranges::copy(digits, chunk.end() - digits.size());
+
+    std::uint64_t word = std::bit_cast<std::uint64_t>(chunk);
+    constexpr std::uint64_t kZeros = 0x3030303030303030;
+    constexpr std::uint64_t kHighBits = 0x8080808080808080;
+
+    if ((((word + 0x4646464646464646) | (word - kZeros)) & kHighBits) != 0) {
+        return std::nullopt;
+    }
+
+    word -= kZeros;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+            (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+           32;
+    return word;
+}
+
+// Parses the digits in `text`, ignoring spaces. Contiguous digit runs (the
+// common case once padding is trimmed) go through the eight-at-a-time path.
+template <Numeric T>
+constexpr auto parse_number(std::string_view text) -> std::optional<T> {
+    const auto first = text.find_first_not_of(' ');
+    if (first == std::string_view::npos) return std::nullopt;
+    text = text.substr(first, text.find_last_not_of(' ') - first + 1);
+
+    if constexpr (std::endian::native == std::endian::little) {
+        T value{0};
+        std::size_t pos = 0;
+        std::size_t len = text.size() % 8 == 0 ? 8 : text.size() % 8;
+
+        for (; pos < text.size(); pos += len, len = 8) {
+            const auto chunk = parse_eight_digits(text.substr(pos, len));
+            if (!chunk) break;
+            value = value * static_cast<T>(100000000) + static_cast<T>(*chunk);
+        }
+
+        if (pos >= text.size()) return value;
+    }
+
+    std::optional<T> value;
+    for (const char c : text) {
+        if (const auto digit = to_digit<T>(c)) {
+            value = value.value_or(T{0}) * T{10} + *digit;
+        }
+    }
+    return value;
+}
+
 template <Numeric T = long long>
 struct Problem {
-    std::vector<T> numbers;
+    std::span<const T> numbers;
     Operation operation;
 
     [[nodiscard]] constexpr auto evaluate() const noexcept -> T {
@@ -73,13 +148,114 @@ struct Problem {
     }
 };
 
+// Structure-of-arrays store for many problems: one flat numbers array,
+// offsets delimiting each problem's slice of it, and one operation each.
+template <Numeric T = long long>
+class ProblemSet {
+public:
+    auto reserve(const std::size_t problems, const std::size_t numbers)
+        -> void {
+        operations_.reserve(problems);
+        offsets_.reserve(problems + 1);
+        numbers_.reserve(numbers);
+    }
+
+    auto begin_problem(const Operation op) -> void {
+        operations_.push_back(op);
+        offsets_.push_back(numbers_.size());
+    }
+
+    auto push(const T number) -> void { numbers_.push_back(number); }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return operations_.size();
+    }
+
+    [[nodiscard]] auto operator[](const std::size_t i) const noexcept
+        -> Problem<T> {
+        return {.numbers = numbers_between(i, i + 1),
+                .operation = operations_[i]};
+    }
+
+    // Runs of additions collapse into a single flat sum over their shared
+    // slice of numbers; only multiplications need a reduction per problem.
+    [[nodiscard]] auto evaluate() const noexcept -> T {
+        T sums{0};
+        T products{0};
+
+        for (std::size_t i = 0; i < size();) {
+            const Operation op = operations_[i];
+            std::size_t j = i;
+            while (j < size() && operations_[j] == op) ++j;
+
+            if (op == Operation::ADD) {
+                const auto run = numbers_between(i, j);
+                sums = std::reduce(run.begin(), run.end(), sums);
+            } else {
+                for (auto k = i; k < j; ++k) products += (*this)[k].evaluate();
+            }
+
+            i = j;
+        }
+
+        return sums + products;
+    }
+
+private:
+    std::vector<T> numbers_;
+    std::vector<std::size_t> offsets_;
+    std::vector<Operation> operations_;
+
+    [[nodiscard]] auto numbers_between(const std::size_t first,
+                                       const std::size_t last) const noexcept
+        -> std::span<const T> {
+        const auto begin = offsets_[first];
+        const auto end = last < size() ? offsets_[last] : numbers_.size();
+        return std::span(numbers_).subspan(begin, end - begin);
+    }
+};
+
+// Contiguous column-major copy of a worksheet: column c occupies
+// [c * height, (c + 1) * height). Built with a tiled transpose so both the
+// row reads and the column writes stay within a few cache lines per tile.
+class ColumnMajorView {
+public:
+    template <StringLike S>
+    ColumnMajorView(const std::vector<S>& rows, const std::size_t width)
+        : height_(rows.size()), cells_(width * rows.size(), ' ') {
+        for (auto r0 = 0uz; r0 < height_; r0 += kTile) {
+            const auto r_end = std::min(r0 + kTile, height_);
+
+            for (auto c0 = 0uz; c0 < width; c0 += kTile) {
+                for (auto r = r0; r < r_end; ++r) {
+                    const std::string_view row = rows[r];
+                    const auto c_end = std::min(c0 + kTile, row.size());
+
+                    for (auto c = c0; c < c_end; ++c) {
+                        cells_[c * height_ + r] = row[c];
+                    }
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] auto column(ColumnIndex col) const noexcept
+        -> std::string_view {
+        return std::string_view(cells_).substr(col.value * height_, height_);
+    }
+
+private:
+    static constexpr std::size_t kTile = 32;
+
+    std::size_t height_;
+    std::string cells_;
+};
+
 template <StringLike S = std::string>
 class Grid {
 public:
     explicit constexpr Grid(const std::vector<S>& data)
-        : data_(data),
-          height_(data.size()),
-          width_(data.empty() ? 0 : data[0].size()) {}
+        : data_(data), height_(data.size()), width_(max_row_width(data)) {}
 
     [[nodiscard]] constexpr auto height() const noexcept -> std::size_t {
         return height_;
@@ -93,100 +269,181 @@ public:
         return {height_ - 1};
     }
 
+    [[nodiscard]] constexpr auto row(RowIndex row) const noexcept
+        -> std::string_view {
+        return data_[row.value];
+    }
+
+    // Rows may be ragged; anything past the end of a row reads as a space.
     [[nodiscard]] constexpr auto at(RowIndex row, ColumnIndex col) const
         -> char {
-        return data_[row.value][col.value];
+        const std::string_view text = data_[row.value];
+        return col.value < text.size() ? text[col.value] : ' ';
     }
 
-    [[nodiscard]] auto is_column_empty(ColumnIndex col) const -> bool {
-        return std::ranges::all_of(
-            std::views::iota(0uz, height_),
-            [this, col](auto r) { return at({r}, col) == ' '; });
+    [[nodiscard]] constexpr auto extract_row_range(
+        RowIndex row, const ColumnRange range) const -> std::string_view {
+        const std::string_view text = data_[row.value];
+        if (range.start.value >= text.size()) return {};
+        return text.substr(range.start.value, range.width());
     }
 
+    // Column `col` read top-to-bottom, stopping before `max_row`. Served from
+    // a transposed copy that is built on first use and reused afterwards.
     [[nodiscard]] auto extract_column(ColumnIndex col, RowIndex max_row) const
-        -> std::string {
-        return std::views::iota(0uz, max_row.value) |
-               std::views::transform(
-                   [this, col](auto r) { return at({r}, col); }) |
-               std::views::filter([](const char c) { return c != ' '; }) |
-               std::ranges::to<std::string>();
-    }
-
-    [[nodiscard]] auto extract_row_range(RowIndex row,
-                                         const ColumnRange range) const
         -> std::string_view {
-        return std::string_view(data_[row.value])
-            .substr(range.start.value, range.width());
+        std::call_once(column_major_once_,
+                       [this] { column_major_.emplace(data_, width_); });
+        return column_major_->column(col).substr(0, max_row.value);
     }
 
 private:
     const std::vector<S>& data_;
     std::size_t height_;
     std::size_t width_;
+    mutable std::optional<ColumnMajorView> column_major_;
+    mutable std::once_flag column_major_once_;
+
+    [[nodiscard]] static constexpr auto max_row_width(
+        const std::vector<S>& data) -> std::size_t {
+        std::size_t width = 0;
+        for (const auto& line : data) {
+            width = std::max(width, std::string_view(line).size());
+        }
+        return width;
+    }
 };
 
-class BlockFinder {
+// One bit per column, set when any row has a non-space character there.
+// Built in a single pass over the row buffers, 16 columns at a time.
+class ColumnOccupancy {
 public:
     template <typename GridType>
-    [[nodiscard]] static auto find_blocks(const GridType& grid)
-        -> std::vector<ColumnRange> {
-        std::vector<ColumnRange> blocks;
-        ColumnIndex col{};
-
-        while (col.value < grid.width()) {
-            auto start = find_next_non_empty_column(grid, col);
-            if (!start) break;
+    [[nodiscard]] static auto build(const GridType& grid) -> ColumnOccupancy {
+        ColumnOccupancy occupancy(grid.width());
 
-            auto end = find_next_empty_column(grid, *start);
-            blocks.emplace_back(*start, ColumnIndex{end.value - 1});
-            col = end;
+        for (auto r = 0uz; r < grid.height(); ++r) {
+            occupancy.mark_row(grid.row({r}));
         }
 
-        return blocks;
+        return occupancy;
+    }
+
+    [[nodiscard]] auto width() const noexcept -> std::size_t { return width_; }
+
+    // First occupied column at or after `from`, or width() if none.
+    [[nodiscard]] auto next_occupied(const ColumnIndex from) const noexcept
+        -> ColumnIndex {
+        return {scan(from.value, 0)};
+    }
+
+    // First empty column at or after `from`, or width() if none.
+    [[nodiscard]] auto next_empty(const ColumnIndex from) const noexcept
+        -> ColumnIndex {
+        return {scan(from.value, ~std::uint64_t{0})};
     }
 
 private:
-    template <typename GridType>
-    static auto find_next_non_empty_column(const GridType& grid,
-                                           ColumnIndex start)
-        -> std::optional<ColumnIndex> {
-        for (auto col = start.value; col < grid.width(); ++col) {
-            if (!grid.is_column_empty({col})) {
-                return ColumnIndex{col};
+    static constexpr std::size_t kWordBits = 64;
+
+    std::vector<std::uint64_t> words_;
+    std::size_t width_;
+
+    explicit ColumnOccupancy(const std::size_t width)
+        : words_((width + kWordBits - 1) / kWordBits), width_(width) {}
+
+    auto mark_row(const std::string_view row) noexcept -> void {
+        std::size_t c = 0;
+
+#if defined(__SSE2__)
+        const __m128i spaces = _mm_set1_epi8(' ');
+
+        for (; c + 16 <= row.size(); c += 16) {
+            const __m128i chunk = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(row.data() + c));
+            const auto space_mask = static_cast<std::uint64_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, spaces)));
+
+            // c is a multiple of 16, so the 16 bits never straddle a word.
+            words_[c / kWordBits] |= (~space_mask & 0xFFFFu)
+                                     << (c % kWordBits);
+        }
+#endif
+
+        for (; c < row.size(); ++c) {
+            if (row[c] != ' ') {
+                words_[c / kWordBits] |= std::uint64_t{1} << (c % kWordBits);
             }
         }
-        return std::nullopt;
     }
 
-    template <typename GridType>
-    static auto find_next_empty_column(const GridType& grid, ColumnIndex start)
-        -> ColumnIndex {
-        for (auto col = start.value; col < grid.width(); ++col) {
-            if (grid.is_column_empty({col})) {
-                return {col};
-            }
+    // Finds the first column >= from whose bit differs from `invert`'s bits.
+    [[nodiscard]] auto scan(const std::size_t from,
+                            const std::uint64_t invert) const noexcept
+        -> std::size_t {
+        if (from >= width_) return width_;
+
+        std::size_t word = from / kWordBits;
+        std::uint64_t bits =
+            (words_[word] ^ invert) & (~std::uint64_t{0} << (from % kWordBits));
+
+        while (bits == 0) {
+            if (++word == words_.size()) return width_;
+            bits = words_[word] ^ invert;
         }
-        return {grid.width()};
+
+        return std::min(width_,
+                        word * kWordBits +
+                            static_cast<std::size_t>(std::countr_zero(bits)));
     }
 };
 
-template <Numeric T = long long>
-class ParserStrategy {
+class BlockFinder {
 public:
-    virtual ~ParserStrategy() = default;
+    template <typename Fn>
+    static auto for_each_block(const ColumnOccupancy& occupancy, Fn&& fn)
+        -> void {
+        ColumnIndex col{};
+
+        while (col.value < occupancy.width()) {
+            const auto start = occupancy.next_occupied(col);
+            if (start.value >= occupancy.width()) break;
 
-    virtual auto parse(const Grid<>& grid, const ColumnRange& range)
-        -> Problem<T> = 0;
+            const auto end = occupancy.next_empty(start);
+            fn(ColumnRange{start, ColumnIndex{end.value - 1}});
+            col = end;
+        }
+    }
+
+    [[nodiscard]] static auto find_blocks(const ColumnOccupancy& occupancy)
+        -> std::vector<ColumnRange> {
+        std::vector<ColumnRange> blocks;
+        for_each_block(occupancy, [&blocks](const ColumnRange& range) {
+            blocks.push_back(range);
+        });
+        return blocks;
+    }
+};
+
+template <typename P, typename T>
+concept WorksheetParser = requires(const Grid<>& grid, const ColumnRange& range,
+                                   ProblemSet<T>& problems) {
+    { P::parse(grid, range, problems) } -> std::same_as<void>;
 };
 
 template <Numeric T = long long>
-class Part1Parser final : public ParserStrategy<T> {
+class Part1Parser {
 public:
-    auto parse(const Grid<>& grid, const ColumnRange& range)
-        -> Problem<T> override {
-        return Problem<T>{.numbers = extract_numbers(grid, range),
-                          .operation = extract_operation(grid, range)};
+    static auto parse(const Grid<>& grid, const ColumnRange& range,
+                      ProblemSet<T>& problems) -> void {
+        problems.begin_problem(extract_operation(grid, range));
+
+        for (auto r = 0uz; r < grid.last_row().value; ++r) {
+            if (const auto number =
+                    parse_number<T>(grid.extract_row_range({r}, range))) {
+                problems.push(*number);
+            }
+        }
     }
 
 private:
@@ -202,39 +459,22 @@ private:
 
         return Operation::ADD;
     }
-
-    [[nodiscard]] static auto extract_numbers(const Grid<>& grid,
-                                              const ColumnRange& range)
-        -> std::vector<T> {
-        auto rows = std::views::iota(0uz, grid.last_row().value);
-
-        return rows | std::views::transform([&](auto r) {
-                   auto row_text = grid.extract_row_range({r}, range);
-                   auto trimmed =
-                       row_text |
-                       std::views::drop_while([](char c) { return c == ' '; }) |
-                       std::views::reverse |
-                       std::views::drop_while([](char c) { return c == ' '; }) |
-                       std::views::reverse | std::ranges::to<std::string>();
-
-                   return trimmed.empty() ? std::optional<T>{}
-                                          : std::optional<T>{static_cast<T>(
-                                                std::stoll(trimmed))};
-               }) |
-               std::views::filter(
-                   [](const auto& opt) { return opt.has_value(); }) |
-               std::views::transform([](const auto& opt) { return *opt; }) |
-               std::ranges::to<std::vector>();
-    }
 };
 
 template <Numeric T = long long>
-class Part2Parser final : public ParserStrategy<T> {
+class Part2Parser {
 public:
-    auto parse(const Grid<>& grid, const ColumnRange& range)
-        -> Problem<T> override {
-        return Problem<T>{.numbers = extract_numbers(grid, range),
-                          .operation = extract_operation(grid, range)};
+    static auto parse(const Grid<>& grid, const ColumnRange& range,
+                      ProblemSet<T>& problems) -> void {
+        problems.begin_problem(extract_operation(grid, range));
+
+        // Right-to-left
+        for (auto c = range.end.value + 1; c-- > range.start.value;) {
+            if (const auto number = parse_number<T>(
+                    grid.extract_column({c}, grid.last_row()))) {
+                problems.push(*number);
+            }
+        }
     }
 
 private:
@@ -251,96 +491,111 @@ private:
         }
         return Operation::ADD;
     }
+};
 
-    [[nodiscard]] static auto extract_numbers(const Grid<>& grid,
-                                              const ColumnRange& range)
-        -> std::vector<T> {
-        // Right-to-left
-        auto columns =
-            std::views::iota(range.start.value, range.end.value + 1) |
-            std::views::reverse;
-
-        return columns | std::views::transform([&](auto c) {
-                   return grid.extract_column({c}, grid.last_row());
-               }) |
-               std::views::filter([](const auto& s) { return !s.empty(); }) |
-               std::views::transform([](const auto& s) {
-                   return static_cast<T>(std::stoll(s));
-               }) |
-               std::ranges::to<std::vector>();
+// Bump whenever ColumnRange or BlockFinder changes, so stale snapshots are
+// ignored.
+inline constexpr std::uint32_t kSnapshotVersion = 1;
+
+// Everything both parts share: the rows, and the blocks found by one
+// occupancy scan over them. Each part then only parses the blocks its own
+// way. The block list is kept in a snapshot, so later runs of the same
+// input map it instead of scanning.
+class Worksheet {
+public:
+    Worksheet(const std::vector<std::string>& rows,
+              const std::string_view input,
+              const std::optional<std::filesystem::path>& snapshot)
+        : grid_(rows),
+          blocks_(AOC::loadOrParse<ColumnRange>(
+              snapshot, kSnapshotVersion, input, [this] {
+                  return BlockFinder::find_blocks(
+                      ColumnOccupancy::build(grid_));
+              })) {}
+
+    [[nodiscard]] auto grid() const noexcept -> const Grid<>& { return grid_; }
+
+    [[nodiscard]] auto blocks() const noexcept -> std::span<const ColumnRange> {
+        return blocks_.view();
     }
+
+private:
+    Grid<> grid_;
+    AOC::SnapshotArrays<ColumnRange> blocks_;
 };
 
-template <typename Derived, Numeric T = long long>
+template <typename Parser, Numeric T = long long>
+    requires WorksheetParser<Parser, T>
 class WorksheetSolver {
 public:
-    [[nodiscard]] auto solve(const std::vector<std::string>& input) -> T {
-        auto problems = parse_problems(input);
-
-        return std::ranges::fold_left(
-            problems | std::views::transform(&Problem<T>::evaluate), T{0},
-            std::plus{});
+    // Blocks are split into contiguous chunks, each parsed into its own
+    // ProblemSet and evaluated as one pool task; partial totals are summed
+    // in chunk order so the result does not depend on scheduling.
+    [[nodiscard]] static auto solve(const Worksheet& worksheet) -> T {
+        const auto blocks = worksheet.blocks();
+
+        return AOC::parallelReduce(
+            0, blocks.size(), kBlocksPerTask, T{0},
+            [&](const std::size_t begin, const std::size_t end) {
+                return solve_blocks(worksheet.grid(),
+                                    blocks.subspan(begin, end - begin));
+            },
+            std::plus<>{});
     }
 
-protected:
-    [[nodiscard]] auto parse_problems(const std::vector<std::string>& input)
-        -> std::vector<Problem<T> > {
-        Grid grid(input);
-        auto blocks = BlockFinder::find_blocks(grid);
-        auto& parser = static_cast<Derived*>(this)->get_parser();
+private:
+    static constexpr std::size_t kBlocksPerTask = 1024;
 
-        return blocks | std::views::transform([&](const auto& range) {
-                   return parser.parse(grid, range);
-               }) |
-               std::ranges::to<std::vector>();
-    }
-};
+    [[nodiscard]] static auto solve_blocks(
+        const Grid<>& grid, std::span<const ColumnRange> blocks) -> T {
+        ProblemSet<T> problems;
+        problems.reserve(blocks.size(), blocks.size() * grid.height());
 
-template <Numeric T = long long>
-class Part1Solver : public WorksheetSolver<Part1Solver<T>, T> {
-public:
-    [[nodiscard]] auto get_parser() -> Part1Parser<T>& { return parser_; }
+        for (const auto& range : blocks) {
+            Parser::parse(grid, range, problems);
+        }
 
-private:
-    Part1Parser<T> parser_;
+        return problems.evaluate();
+    }
 };
 
 template <Numeric T = long long>
-class Part2Solver : public WorksheetSolver<Part2Solver<T>, T> {
-public:
-    [[nodiscard]] auto get_parser() -> Part2Parser<T>& { return parser_; }
+using Part1Solver = WorksheetSolver<Part1Parser<T>, T>;
 
-private:
-    Part2Parser<T> parser_;
-};
+template <Numeric T = long long>
+using Part2Solver = WorksheetSolver<Part2Parser<T>, T>;
 
-[[nodiscard]] inline auto part1(const std::vector<std::string>& input)
-    -> long long {
-    return Part1Solver{}.solve(input);
+[[nodiscard]] inline auto part1(const Worksheet& worksheet) -> long long {
+    return Part1Solver<>::solve(worksheet);
 }
 
-[[nodiscard]] inline auto part2(const std::vector<std::string>& input)
-    -> long long {
-    return Part2Solver{}.solve(input);
+[[nodiscard]] inline auto part2(const Worksheet& worksheet) -> long long {
+    return Part2Solver<>::solve(worksheet);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        const auto input = AOC::fetchAOCInputVector(2025, 6);
-        std::println("Input lines: {}", input.size());
-
-        const auto part1_ans = std::to_string(part1(input));
-        const auto part2_ans = std::to_string(part2(input));
-
-        std::println("Part 1: {}", part1_ans);
-        std::println("Part 2: {}", part2_ans);
-
-        AOC::submitAnswer(2025, 6, 1, part1_ans);
-        AOC::submitAnswer(2025, 6, 2, part2_ans);
+        AOC::Runner runner(2025, 6, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
+        const std::string input = runner.rawInput();
+
+        // Grid owns a once_flag, so the worksheet is built in place.
+        std::vector<std::string> lines;
+        std::optional<Worksheet> worksheet;
+        runner.phase("parse", [&] {
+            lines = AOC::splitLines(input);
+            worksheet.emplace(lines, input, runner.snapshotPath("blocks"));
+        });
+        std::println("Input lines: {}", lines.size());
+
+        runner.answer(1,
+                      runner.phase("part1", [&] { return part1(*worksheet); }));
+        runner.answer(2,
+                      runner.phase("part2", [&] { return part2(*worksheet); }));
+
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << std::format("Error: {}\n", e.what());
         return 1;
     }
-
-    return 0;
 }
@@ -1,15 +1,27 @@
 #include <algorithm>
+#include <bit>
 #include <concepts>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <istream>
 #include <map>
+#include <numeric>
+#include <optional>
 #include <print>
+#include <random>
 #include <ranges>
 #include <set>
+#include <span>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Differential.hpp"
+#include "Embedded.hpp"
+#include "Runner.hpp"
 
 template <typename T>
 concept Integral = std::integral<T>;
@@ -79,6 +91,10 @@ public:
         return to_cell_type(at(pos));
     }
 
+    [[nodiscard]] constexpr auto row(int r) const -> std::string_view {
+        return data[r];
+    }
+
     [[nodiscard]] auto findStart() const -> Position {
         for (int r = 0; r < rows; ++r) {
             for (int c = 0; c < cols; ++c) {
@@ -104,19 +120,79 @@ private:
     int rows, cols;
 };
 
+inline constexpr int kWordBits = 64;
+
+[[nodiscard]] constexpr auto words_for(const int cols) noexcept -> std::size_t {
+    return static_cast<std::size_t>((cols + kWordBits - 1) / kWordBits);
+}
+
+// Advances packed beam columns (one bit per column, 64 per word) through one
+// row whose splitters are given as a mask of the same shape:
+//   next = (beams & ~split) | (beams & split) << 1 | (beams & split) >> 1
+// Returns the number of beams that hit a splitter.
+template <Integral T>
+[[nodiscard]] auto advance_beams(std::span<const std::uint64_t> beams,
+                                 std::span<const std::uint64_t> split,
+                                 std::span<std::uint64_t> next,
+                                 const int cols) noexcept -> T {
+    const std::size_t words = beams.size();
+    const auto hit = [&](const std::size_t w) -> std::uint64_t {
+        return w < words ? beams[w] & split[w] : 0;
+    };
+
+    T splits = 0;
+    std::uint64_t prev_hit = 0;
+
+    for (std::size_t w = 0; w < words; ++w) {
+        const std::uint64_t cur_hit = hit(w);
+        const std::uint64_t right = (cur_hit << 1) | (prev_hit >> 63);
+        const std::uint64_t left = (cur_hit >> 1) | (hit(w + 1) << 63);
+
+        next[w] = (beams[w] & ~split[w]) | left | right;
+        splits += std::popcount(cur_hit);
+        prev_hit = cur_hit;
+    }
+
+    // Beams split past the right edge leave the manifold.
+    if (const int tail = cols % kWordBits; tail != 0) {
+        next[words - 1] &= (std::uint64_t{1} << tail) - 1;
+    }
+
+    return splits;
+}
+
+// Whole-grid solvers for a particle entering at any position, where the
+// scanner below only follows the 'S' in a stream of rows.
 template <Integral T = long long>
 class BeamSimulator {
 public:
-    explicit constexpr BeamSimulator(const Grid<>& grid_) : grid(grid_) {}
+    explicit BeamSimulator(const Grid<>& grid_)
+        : grid(grid_),
+          words(words_for(grid_.getCols())),
+          splitters(static_cast<std::size_t>(grid_.getRows()) * words) {
+        for (const Position pos : grid.positions()) {
+            if (grid.cellType(pos) == CellType::SPLITTER) {
+                splitters[pos.row * words + pos.col / kWordBits] |=
+                    std::uint64_t{1} << (pos.col % kWordBits);
+            }
+        }
+    }
 
     [[nodiscard]] auto count_splits(const Position start) const -> T {
-        std::set<int> beam_positions{start.col};
+        if (words == 0) return T{0};
+
+        std::vector<std::uint64_t> beams(words);
+        std::vector<std::uint64_t> next(words);
+        beams[start.col / kWordBits] |= std::uint64_t{1}
+                                        << (start.col % kWordBits);
         T total_splits = 0;
 
-        for (int row : std::views::iota(0, grid.getRows())) {
-            auto [next_pos, splits] = process_row(beam_positions, row);
-            beam_positions = std::move(next_pos);
-            total_splits += splits;
+        for (int row : std::views::iota(start.row, grid.getRows())) {
+            const auto split =
+                std::span(splitters).subspan(row * words, words);
+            total_splits +=
+                advance_beams<T>(beams, split, next, grid.getCols());
+            std::swap(beams, next);
         }
 
         return total_splits;
@@ -124,35 +200,108 @@ public:
 
 private:
     const Grid<>& grid;
+    std::size_t words;
+    std::vector<std::uint64_t> splitters;
+};
+
+// Forward timeline DP carried one row at a time. `spread` holds the counts
+// that splitters in the previous row pushed into this one and `through` the
+// counts that passed straight down; a splitter only contributes if another
+// row follows, so the answer is what passed through the final row.
+template <Integral T = long long>
+class TimelineRow {
+public:
+    explicit TimelineRow(const int cols)
+        : through_(cols), spread_(cols), split_(cols) {}
+
+    auto enter(const int col) -> void { spread_[col] += 1; }
+
+    auto advance(const std::string_view row) -> void {
+        const std::size_t cols = through_.size();
+
+        for (std::size_t c = 0; c < cols; ++c) {
+            const T count = through_[c] + spread_[c];
+            const bool splits = row[c] == '^';
+            split_[c] = splits ? count : T{0};
+            through_[c] = splits ? T{0} : count;
+        }
+
+        for (std::size_t c = 0; c < cols; ++c) {
+            spread_[c] = (c > 0 ? split_[c - 1] : T{0}) +
+                         (c + 1 < cols ? split_[c + 1] : T{0});
+        }
+    }
 
-    [[nodiscard]] auto process_row(const std::set<int>& current_positions,
-                                   const int row) const
-        -> std::pair<std::set<int>, T> {
-        std::set<int> next_positions;
-        T splits = 0;
-
-        for (int col : current_positions) {
-            Position pos{row, col};
-
-            if (!grid.isValid(pos)) continue;
-
-            switch (grid.cellType(pos)) {
-                case CellType::SPLITTER:
-                    ++splits;
-                    if (col - 1 >= 0) next_positions.insert(col - 1);
-                    if (col + 1 < grid.getCols())
-                        next_positions.insert(col + 1);
-                    break;
-
-                case CellType::EMPTY:
-                case CellType::START:
-                    next_positions.insert(col);
-                    break;
+    [[nodiscard]] auto exited() const -> T {
+        return std::reduce(through_.begin(), through_.end(), T{0});
+    }
+
+private:
+    std::vector<T> through_;
+    std::vector<T> spread_;
+    std::vector<T> split_;
+};
+
+// Timeline counts for every entry cell, filled by one backward pass. A row
+// without splitters has exactly the counts of the row below it, so only
+// rows containing a splitter get their own storage and the rest point at
+// the next stored row. Any query is then O(1).
+template <Integral T = long long>
+class TimelineTable {
+public:
+    explicit TimelineTable(const Grid<>& grid)
+        : cols(grid.getCols()), row_slot(grid.getRows()) {
+        // Slot 0 is the virtual row below the grid: every column exits.
+        counts.assign(cols, T{1});
+        std::size_t below = 0;
+
+        for (int r = grid.getRows() - 1; r >= 0; --r) {
+            const auto row = grid.row(r);
+
+            if (row.find('^') == std::string_view::npos) {
+                row_slot[r] = below;
+                continue;
             }
+
+            const bool has_next = r + 1 < grid.getRows();
+            const std::size_t slot = counts.size() / cols;
+            counts.resize(counts.size() + cols);
+
+            for (int c = 0; c < cols; ++c) {
+                T result = 0;
+
+                if (to_cell_type(row[c]) != CellType::SPLITTER) {
+                    result = counts[below * cols + c];
+                } else if (has_next) {
+                    if (c - 1 >= 0) result += counts[below * cols + c - 1];
+                    if (c + 1 < cols) result += counts[below * cols + c + 1];
+                }
+
+                counts[slot * cols + c] = result;
+            }
+
+            row_slot[r] = below = slot;
+        }
+    }
+
+    // Number of timelines for a particle entering at `pos`; positions off
+    // the grid count as one finished timeline, as in the single-start case.
+    [[nodiscard]] auto at(const Position pos) const -> T {
+        if (pos.row < 0 || pos.col < 0 || pos.col >= cols ||
+            pos.row >= static_cast<int>(row_slot.size())) {
+            return T{1};
         }
+        return counts[row_slot[pos.row] * cols + pos.col];
+    }
 
-        return {next_positions, splits};
+    [[nodiscard]] auto stored_rows() const noexcept -> std::size_t {
+        return cols == 0 ? 0 : counts.size() / cols;
     }
+
+private:
+    int cols;
+    std::vector<std::size_t> row_slot;
+    std::vector<T> counts;
 };
 
 template <Integral T = long long>
@@ -161,118 +310,314 @@ public:
     explicit constexpr QuantumTimelineCounter(const Grid<>& grid_)
         : grid(grid_) {}
 
-    [[nodiscard]] constexpr auto count_timelines(const Position start) const
-        -> T {
-        memo.clear();
-        return count_impl(start);
+    [[nodiscard]] auto count_timelines(const Position start) const -> T {
+        if (!grid.isValid(start)) return T{1};
+
+        TimelineRow<T> timelines(grid.getCols());
+        timelines.enter(start.col);
+
+        for (int row : std::views::iota(start.row, grid.getRows())) {
+            timelines.advance(grid.row(row));
+        }
+
+        return timelines.exited();
+    }
+
+    [[nodiscard]] auto count_all() const -> TimelineTable<T> {
+        return TimelineTable<T>(grid);
     }
 
 private:
     const Grid<>& grid;
-    mutable std::map<Position, T> memo;
+};
 
-    [[nodiscard]] auto count_impl(Position pos) const -> T {
-        if (!grid.isValid(pos)) return T{1};
+// Solves both parts in one pass over rows as they arrive, keeping only one
+// row of beam bits and timeline counts. Nothing happens until the row
+// holding 'S'; the first row fixes the width.
+template <Integral T = long long>
+class ManifoldScanner {
+public:
+    [[nodiscard]] static auto scan(std::istream& input) -> ManifoldScanner {
+        ManifoldScanner scanner;
 
-        if (auto it = memo.find(pos); it != memo.end()) return it->second;
+        for (std::string line; std::getline(input, line);) {
+            if (!line.empty()) scanner.feed(line);
+        }
 
-        T result = 0;
+        return scanner;
+    }
 
-        switch (grid.cellType(pos)) {
-            case CellType::SPLITTER: {
-                // Quantum split: particle takes both paths
-                const Position left = pos.move_left();
-                const Position right = pos.move_right();
+    auto feed(const std::string_view row) -> void {
+        if (!timelines) {
+            cols = static_cast<int>(row.size());
+            beams.resize(words_for(cols));
+            next.resize(beams.size());
+            split.resize(beams.size());
+            timelines.emplace(cols);
+        }
 
-                if (grid.isValid({pos.row + 1, left.col}))
-                    result += count_impl(left);
-                if (grid.isValid({pos.row + 1, right.col}))
-                    result += count_impl(right);
-                break;
-            }
+        if (!started) {
+            const auto start = row.find('S');
+            if (start == std::string_view::npos) return;
+
+            started = true;
+            beams[start / kWordBits] |= std::uint64_t{1}
+                                        << (start % kWordBits);
+            timelines->enter(static_cast<int>(start));
+        }
 
-            case CellType::EMPTY:
-            case CellType::START:
-                result = count_impl(pos.move_down());
-                break;
+        std::ranges::fill(split, 0);
+        for (int c = 0; c < cols; ++c) {
+            if (to_cell_type(row[c]) == CellType::SPLITTER) {
+                split[c / kWordBits] |= std::uint64_t{1} << (c % kWordBits);
+            }
         }
 
-        memo[pos] = result;
-        return result;
+        total_splits += advance_beams<T>(beams, split, next, cols);
+        std::swap(beams, next);
+        timelines->advance(row);
+    }
+
+    [[nodiscard]] auto splits() const noexcept -> T { return total_splits; }
+
+    [[nodiscard]] auto timeline_count() const -> T {
+        return started ? timelines->exited() : T{0};
     }
+
+private:
+    int cols = 0;
+    bool started = false;
+    T total_splits = 0;
+    std::vector<std::uint64_t> beams;
+    std::vector<std::uint64_t> next;
+    std::vector<std::uint64_t> split;
+    std::optional<TimelineRow<T>> timelines;
 };
 
-template <typename Derived, Integral T = long long>
-class SolutionStrategy {
-public:
-    [[nodiscard]] auto solve() const -> T {
-        Position start = grid.findStart();
-        return static_cast<const Derived*>(this)->solve_impl(start);
+// Plain oracles for ManifoldScanner, straight from the rules: a set of beam
+// columns moved one row at a time, and timelines counted by memoized
+// recursion over (row, column). Like the scanner, both start at the first
+// 'S', and a beam split on the last row ends no timeline.
+struct ReferenceManifold {
+    const std::vector<std::string>& rows;
+
+    [[nodiscard]] auto start() const -> std::optional<Position> {
+        for (int r = 0; r < static_cast<int>(rows.size()); ++r) {
+            if (const auto c = rows[r].find('S'); c != std::string::npos) {
+                return Position{r, static_cast<int>(c)};
+            }
+        }
+        return std::nullopt;
     }
 
-protected:
-    const Grid<> grid;
+    [[nodiscard]] auto splits() const -> long long {
+        const auto from = start();
+        if (!from) return 0;
 
-    explicit constexpr SolutionStrategy(const std::vector<std::string>& input)
-        : grid(input) {}
-};
+        const int cols = static_cast<int>(rows[0].size());
+        std::set<int> beams{from->col};
+        long long count = 0;
 
-template <Integral T = long long>
-class Part1Solution : public SolutionStrategy<Part1Solution<T>, T> {
-public:
-    explicit constexpr Part1Solution(const std::vector<std::string>& input)
-        : SolutionStrategy<Part1Solution<T>, T>(input) {}
+        for (int r = from->row; r < static_cast<int>(rows.size()); ++r) {
+            std::set<int> next;
+            for (const int c : beams) {
+                if (rows[r][c] != '^') {
+                    next.insert(c);
+                    continue;
+                }
+                ++count;
+                if (c > 0) next.insert(c - 1);
+                if (c + 1 < cols) next.insert(c + 1);
+            }
+            beams = std::move(next);
+        }
 
-private:
-    friend SolutionStrategy<Part1Solution<T>, T>;
+        return count;
+    }
 
-    [[nodiscard]] auto solve_impl(Position start) const -> T {
-        BeamSimulator<T> simulator(this->grid);
-        return simulator.count_splits(start);
+    [[nodiscard]] auto timelines() const -> long long {
+        const auto from = start();
+        if (!from) return 0;
+
+        std::map<std::pair<int, int>, long long> memo;
+        return timelines_from(from->row, from->col, memo);
     }
-};
 
-template <Integral T = long long>
-class Part2Solution : public SolutionStrategy<Part2Solution<T>, T> {
-public:
-    explicit constexpr Part2Solution(const std::vector<std::string>& input)
-        : SolutionStrategy<Part2Solution<T>, T>(input) {}
+    // Timelines for a particle entering at each cell, in row-major order.
+    [[nodiscard]] auto all_timelines() const -> std::vector<long long> {
+        std::map<std::pair<int, int>, long long> memo;
+        std::vector<long long> counts;
+
+        for (int r = 0; r < static_cast<int>(rows.size()); ++r) {
+            for (int c = 0; c < static_cast<int>(rows[r].size()); ++c) {
+                counts.push_back(timelines_from(r, c, memo));
+            }
+        }
+
+        return counts;
+    }
 
 private:
-    friend SolutionStrategy<Part2Solution<T>, T>;
+    [[nodiscard]] auto timelines_from(
+        const int r, const int c,
+        std::map<std::pair<int, int>, long long>& memo) const -> long long {
+        const int height = static_cast<int>(rows.size());
+        if (c < 0 || c >= static_cast<int>(rows[0].size())) return 0;
+        if (r == height) return 1;
+
+        if (const auto it = memo.find({r, c}); it != memo.end()) {
+            return it->second;
+        }
 
-    [[nodiscard]] auto solve_impl(Position start) const -> T {
-        QuantumTimelineCounter<T> counter(this->grid);
-        return counter.count_timelines(start);
+        long long count = 0;
+        if (rows[r][c] != '^') {
+            count = timelines_from(r + 1, c, memo);
+        } else if (r + 1 < height) {
+            count = timelines_from(r + 1, c - 1, memo) +
+                    timelines_from(r + 1, c + 1, memo);
+        }
+
+        return memo[{r, c}] = count;
     }
 };
 
-[[nodiscard]] inline auto part1(const std::vector<std::string>& input)
-    -> long long {
-    return Part1Solution(input).solve();
+[[nodiscard]] inline auto scan_rows(const std::vector<std::string>& rows)
+    -> ManifoldScanner<> {
+    ManifoldScanner<> scanner;
+    for (const auto& row : rows) scanner.feed(row);
+    return scanner;
+}
+
+// Folds per-cell counts in row-major order into one value, so that the
+// suite can compare whole tables. Any single differing count changes it.
+template <typename CountAt>
+[[nodiscard]] auto fold_counts(const std::vector<std::string>& rows,
+                               CountAt&& count_at) -> long long {
+    std::uint64_t folded = 0;
+    for (int r = 0; r < static_cast<int>(rows.size()); ++r) {
+        for (int c = 0; c < static_cast<int>(rows[r].size()); ++c) {
+            folded = folded * 1'000'003 +
+                     static_cast<std::uint64_t>(count_at(Position{r, c}));
+        }
+    }
+    return static_cast<long long>(folded);
 }
 
-[[nodiscard]] inline auto part2(const std::vector<std::string>& input)
-    -> long long {
-    return Part2Solution(input).solve();
+// Rectangular grids of '.' and '^' with one 'S' in the top rows.
+[[nodiscard]] inline auto differential_suite()
+    -> AOC::DifferentialSuite<std::vector<std::string>> {
+    using Rows = std::vector<std::string>;
+
+    AOC::DifferentialSuite<Rows> suite(
+        [](std::mt19937_64& rng, const std::size_t size) {
+            const auto height = static_cast<int>(2 + size / 2);
+            const auto width = static_cast<int>(1 + size / 3);
+            std::bernoulli_distribution splitter(
+                std::uniform_real_distribution(0.05, 0.5)(rng));
+
+            Rows rows(height, std::string(width, '.'));
+            for (auto& row : rows) {
+                for (auto& cell : row) cell = splitter(rng) ? '^' : '.';
+            }
+            const int r = std::uniform_int_distribution(0, height / 4)(rng);
+            const int c = std::uniform_int_distribution(0, width - 1)(rng);
+            rows[r][c] = 'S';
+            return rows;
+        },
+        [](const Rows& rows) {
+            std::vector<Rows> smaller;
+            for (std::size_t r = 0; r < rows.size(); ++r) {
+                if (rows[r].contains('S')) continue;
+                auto without = rows;
+                without.erase(without.begin() + static_cast<long>(r));
+                smaller.push_back(std::move(without));
+            }
+            for (const bool front : {true, false}) {
+                if (rows[0].size() <= 1) break;
+                const std::size_t col = front ? 0 : rows[0].size() - 1;
+                const auto holds_start = [&](const auto& row) {
+                    return row[col] == 'S';
+                };
+                if (std::ranges::any_of(rows, holds_start)) continue;
+                auto narrower = rows;
+                for (auto& row : narrower) row.erase(col, 1);
+                smaller.push_back(std::move(narrower));
+            }
+            for (std::size_t r = 0; r < rows.size(); ++r) {
+                for (std::size_t c = 0; c < rows[r].size(); ++c) {
+                    if (rows[r][c] != '^') continue;
+                    auto cleared = rows;
+                    cleared[r][c] = '.';
+                    smaller.push_back(std::move(cleared));
+                }
+            }
+            return smaller;
+        },
+        [](const Rows& rows) {
+            std::string text;
+            for (const auto& row : rows) text += row + '\n';
+            text.pop_back();
+            return text;
+        });
+
+    suite.add(
+        "part1",
+        [](const Rows& rows) { return ReferenceManifold{rows}.splits(); },
+        [](const Rows& rows) { return scan_rows(rows).splits(); });
+    suite.add(
+        "part2",
+        [](const Rows& rows) { return ReferenceManifold{rows}.timelines(); },
+        [](const Rows& rows) { return scan_rows(rows).timeline_count(); });
+    suite.add(
+        "part1 grid",
+        [](const Rows& rows) { return ReferenceManifold{rows}.splits(); },
+        [](const Rows& rows) {
+            const Grid<> grid(rows);
+            return BeamSimulator<>(grid).count_splits(grid.findStart());
+        });
+    suite.add(
+        "part2 grid",
+        [](const Rows& rows) { return ReferenceManifold{rows}.timelines(); },
+        [](const Rows& rows) {
+            const Grid<> grid(rows);
+            return QuantumTimelineCounter<>(grid).count_timelines(
+                grid.findStart());
+        });
+    suite.add(
+        "timeline table",
+        [](const Rows& rows) {
+            const auto counts = ReferenceManifold{rows}.all_timelines();
+            auto next = counts.begin();
+            return fold_counts(rows, [&](Position) { return *next++; });
+        },
+        [](const Rows& rows) {
+            const Grid<> grid(rows);
+            const auto table = QuantumTimelineCounter<>(grid).count_all();
+            return fold_counts(
+                rows, [&](const Position pos) { return table.at(pos); });
+        });
+    return suite;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        std::vector<std::string> input = AOC::fetchAOCInputVector(2025, 7);
+        if (const auto options =
+                AOC::DifferentialOptions::fromArgs(argc, argv)) {
+            return differential_suite().run(*options);
+        }
 
-        std::string part1_ans = std::to_string(part1(input));
-        std::string part2_ans = std::to_string(part2(input));
+        AOC::Runner runner(2025, 7, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
+        std::istringstream input(runner.rawInput());
+        const auto scanner = runner.phase(
+            "scan", [&] { return ManifoldScanner<>::scan(input); });
 
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
+        runner.answer(1, scanner.splits());
+        runner.answer(2, scanner.timeline_count());
 
-        AOC::submitAnswer(2025, 7, 1, part1_ans);
-        AOC::submitAnswer(2025, 7, 2, part2_ans);
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
 }
@@ -1,17 +1,29 @@
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstdint>
 #include <functional>
 #include <iostream>
-#include <map>
 #include <numeric>
+#include <optional>
 #include <print>
+#include <random>
 #include <ranges>
-#include <set>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Differential.hpp"
+#include "Embedded.hpp"
+#include "Parallel.hpp"
+#include "Runner.hpp"
+#include "Snapshot.hpp"
 
 template <typename T>
 concept Numeric = std::integral<T> || std::floating_point<T>;
@@ -44,21 +56,34 @@ struct Edge {
     constexpr auto operator<=>(const Edge&) const = default;
 };
 
-template <Numeric T = int>
+// Union-find over 32-bit indices with parent and size kept in separate
+// arrays. It also tracks the live component count and a histogram of
+// component sizes, so connectivity and the largest sizes never need a pass
+// over the nodes.
 class DisjointSetUnion {
 public:
-    explicit DisjointSetUnion(T n) : parent_(n), size_(n, 1) {
-        std::iota(parent_.begin(), parent_.end(), T{0});
+    explicit DisjointSetUnion(const std::uint32_t n)
+        : parent_(n), size_(n, 1), sizeCount_(n + 1),
+          nonEmpty_(n / 64 + 1), nonEmptyWords_(n / 4096 + 1),
+          components_(n), largest_(n == 0 ? 0 : 1) {
+        std::iota(parent_.begin(), parent_.end(), std::uint32_t{0});
+        if (n > 0) {
+            sizeCount_[1] = n;
+            nonEmpty_[0] = bit(1);
+            nonEmptyWords_[0] = bit(0);
+        }
     }
 
-    [[nodiscard]] auto find(T x) -> T {
-        if (parent_[x] != x) {
-            parent_[x] = find(parent_[x]);
+    // Iterative path halving: every visited node skips to its grandparent.
+    [[nodiscard]] auto find(std::uint32_t x) -> std::uint32_t {
+        while (parent_[x] != x) {
+            parent_[x] = parent_[parent_[x]];
+            x = parent_[x];
         }
-        return parent_[x];
+        return x;
     }
 
-    auto unite(T a, T b) -> bool {
+    auto unite(std::uint32_t a, std::uint32_t b) -> bool {
         a = find(a);
         b = find(b);
 
@@ -68,40 +93,115 @@ public:
             std::swap(a, b);
         }
 
+        removeSize(size_[a]);
+        removeSize(size_[b]);
+
         parent_[b] = a;
         size_[a] += size_[b];
+
+        addSize(size_[a]);
+        largest_ = std::max(largest_, size_[a]);
+        --components_;
         return true;
     }
 
-    [[nodiscard]] auto getSize(T x) -> T { return size_[find(x)]; }
+    [[nodiscard]] auto getSize(const std::uint32_t x) -> std::uint32_t {
+        return size_[find(x)];
+    }
 
-    [[nodiscard]] auto isConnected(T a, T b) -> bool {
+    [[nodiscard]] auto isConnected(const std::uint32_t a,
+                                   const std::uint32_t b) -> bool {
         return find(a) == find(b);
     }
 
-    [[nodiscard]] auto countComponents() const -> std::size_t {
-        std::set<T> roots;
-        for (std::size_t i = 0; i < parent_.size(); ++i) {
-            roots.insert(parent_[i]);
+    [[nodiscard]] auto countComponents() const noexcept -> std::size_t {
+        return components_;
+    }
+
+    [[nodiscard]] auto isFullyConnected() const noexcept -> bool {
+        return components_ <= 1;
+    }
+
+    // Sizes of the k largest components, largest first. Steps from one
+    // non-empty size to the next through a two-level bitmap, so the cost
+    // grows with k and the number of 64-size words skipped, not with the
+    // largest size.
+    [[nodiscard]] auto largestSizes(const std::size_t k) const
+        -> std::vector<std::uint32_t> {
+        std::vector<std::uint32_t> sizes;
+        sizes.reserve(std::min<std::size_t>(k, components_));
+
+        for (std::uint32_t s = largest_; s > 0 && sizes.size() < k;
+             s = previousSize(s - 1)) {
+            const std::size_t copies =
+                std::min<std::size_t>(sizeCount_[s], k - sizes.size());
+            sizes.insert(sizes.end(), copies, s);
         }
-        return roots.size();
+
+        return sizes;
     }
 
 private:
-    std::vector<T> parent_;
-    std::vector<T> size_;
+    static constexpr auto bit(const std::uint32_t i) -> std::uint64_t {
+        return std::uint64_t{1} << i;
+    }
+
+    // Bits 0 through i.
+    static constexpr auto bitsUpTo(const std::uint32_t i) -> std::uint64_t {
+        return i == 63 ? ~std::uint64_t{0} : bit(i + 1) - 1;
+    }
+
+    auto addSize(const std::uint32_t s) -> void {
+        if (sizeCount_[s]++ == 0) {
+            nonEmpty_[s / 64] |= bit(s % 64);
+            nonEmptyWords_[s / 4096] |= bit(s / 64 % 64);
+        }
+    }
+
+    auto removeSize(const std::uint32_t s) -> void {
+        if (--sizeCount_[s] != 0) return;
+
+        nonEmpty_[s / 64] &= ~bit(s % 64);
+        if (nonEmpty_[s / 64] == 0) {
+            nonEmptyWords_[s / 4096] &= ~bit(s / 64 % 64);
+        }
+    }
+
+    // The largest size at most s held by some component, or 0 if none.
+    [[nodiscard]] auto previousSize(const std::uint32_t s) const
+        -> std::uint32_t {
+        std::uint32_t word = s / 64;
+        std::uint64_t bits = nonEmpty_[word] & bitsUpTo(s % 64);
+
+        if (bits == 0) {
+            if (word == 0) return 0;
+            std::uint32_t group = (word - 1) / 64;
+            std::uint64_t words =
+                nonEmptyWords_[group] & bitsUpTo((word - 1) % 64);
+            while (words == 0) {
+                if (group == 0) return 0;
+                words = nonEmptyWords_[--group];
+            }
+            word = group * 64 + 63 - std::countl_zero(words);
+            bits = nonEmpty_[word];
+        }
+
+        return word * 64 + 63 - std::countl_zero(bits);
+    }
+
+    std::vector<std::uint32_t> parent_;
+    std::vector<std::uint32_t> size_;
+    std::vector<std::uint32_t> sizeCount_;
+    // Bit s is set while some component has size s; bit w of the second
+    // level is set while word w of the first is non-zero.
+    std::vector<std::uint64_t> nonEmpty_;
+    std::vector<std::uint64_t> nonEmptyWords_;
+    std::uint32_t components_;
+    std::uint32_t largest_;
 };
 
 class InputParser {
 public:
-    [[nodiscard]] static auto parse(const std::vector<std::string>& input)
-        -> std::pair<std::vector<Point>, std::vector<Edge>> {
-        auto points = parsePoints(input);
-        auto edges = generateEdges(points);
-        return {std::move(points), std::move(edges)};
-    }
-
-private:
     [[nodiscard]] static auto parsePoints(const std::vector<std::string>& input)
         -> std::vector<Point> {
         return input |
@@ -111,6 +211,7 @@ private:
                std::ranges::to<std::vector>();
     }
 
+private:
     [[nodiscard]] static auto parsePoint(const std::string& line) -> Point {
         long long x, y, z;
 
@@ -130,166 +231,1023 @@ private:
 
         return {x, y, z};
     }
+};
 
-    [[nodiscard]] static auto generateEdges(const std::vector<Point>& points)
-        -> std::vector<Edge> {
-        const int n = static_cast<int>(points.size());
-        std::vector<Edge> edges;
-        edges.reserve(static_cast<std::size_t>(n) * (n - 1) / 2);
+template <typename S>
+concept EdgeSource = requires(S source) {
+    { source.next() } -> std::same_as<std::optional<Edge>>;
+};
+
+struct EdgeOrder {
+    constexpr auto operator()(const Edge& a, const Edge& b) const noexcept
+        -> bool {
+        return std::tie(a.distanceSquared, a.u, a.v) <
+               std::tie(b.distanceSquared, b.u, b.v);
+    }
+};
 
-        for (int i = 0; i < n; ++i) {
-            for (int j = i + 1; j < n; ++j) {
-                const long long dist2 = points[i].distanceSquared(points[j]);
-                edges.push_back({i, j, dist2});
+// Heap comparator that keeps the shortest edge on top.
+struct LongerEdge {
+    constexpr auto operator()(const Edge& a, const Edge& b) const noexcept
+        -> bool {
+        return EdgeOrder{}(b, a);
+    }
+};
+
+[[nodiscard]] inline auto workerCount(const std::size_t items,
+                                      const std::size_t minPerWorker)
+    -> std::size_t {
+    return std::clamp(items / minPerWorker, std::size_t{1},
+                      AOC::threadCount());
+}
+
+// Runs fn(w) for w in [0, workers) as separate pool tasks.
+template <typename Fn>
+auto runWorkers(const std::size_t workers, Fn&& fn) -> void {
+    AOC::parallelFor(0, workers, 1,
+                     [&fn](const std::size_t begin, const std::size_t end) {
+                         for (std::size_t w = begin; w < end; ++w) fn(w);
+                     });
+}
+
+// Stable parallel LSD radix sort on the low `bits` bits of each key, one
+// byte per pass. Each worker histograms and then scatters its own slice.
+inline auto radixSort(std::span<std::uint64_t> keys, const int bits) -> void {
+    constexpr int kDigitBits = 8;
+    constexpr std::size_t kBuckets = std::size_t{1} << kDigitBits;
+
+    const std::size_t workers = workerCount(keys.size(), 1 << 16);
+    const std::size_t chunk = (keys.size() + workers - 1) / workers;
+
+    std::vector<std::uint64_t> buffer(keys.size());
+    std::span<std::uint64_t> src = keys;
+    std::span<std::uint64_t> dst = buffer;
+    std::vector<std::array<std::size_t, kBuckets>> offsets(workers);
+
+    const auto slice = [&](const std::size_t w) {
+        const std::size_t begin = std::min(w * chunk, src.size());
+        return std::pair{begin, std::min(begin + chunk, src.size())};
+    };
+
+    for (int shift = 0; shift < bits; shift += kDigitBits) {
+        const auto digit = [shift](const std::uint64_t key) {
+            return (key >> shift) & (kBuckets - 1);
+        };
+
+        runWorkers(workers, [&](const std::size_t w) {
+            offsets[w].fill(0);
+            const auto [begin, end] = slice(w);
+            for (auto i = begin; i < end; ++i) ++offsets[w][digit(src[i])];
+        });
+
+        std::size_t total = 0;
+        for (std::size_t d = 0; d < kBuckets; ++d) {
+            for (std::size_t w = 0; w < workers; ++w) {
+                const std::size_t count = offsets[w][d];
+                offsets[w][d] = total;
+                total += count;
             }
         }
 
-        std::ranges::sort(edges, {}, &Edge::distanceSquared);
-        return edges;
+        runWorkers(workers, [&](const std::size_t w) {
+            const auto [begin, end] = slice(w);
+            for (auto i = begin; i < end; ++i) {
+                dst[offsets[w][digit(src[i])]++] = src[i];
+            }
+        });
+
+        std::swap(src, dst);
+    }
+
+    if (src.data() != keys.data()) std::ranges::copy(src, keys.begin());
+}
+
+// Coordinates split into separate arrays for the pairwise distance kernel.
+struct PointColumns {
+    std::vector<long long> x, y, z;
+
+    explicit PointColumns(std::span<const Point> points) {
+        x.reserve(points.size());
+        y.reserve(points.size());
+        z.reserve(points.size());
+
+        for (const auto& p : points) {
+            x.push_back(p.x);
+            y.push_back(p.y);
+            z.push_back(p.z);
+        }
     }
 };
 
-class ConstellationAnalyzer {
+// Every pair u < v packed into one 64-bit key: the squared distance in the
+// high bits and the pair's row-major index in the low `pairBits` bits, so
+// comparing keys compares (distance, u, v). A third of the size of an Edge.
+class PackedPairs {
 public:
-    explicit ConstellationAnalyzer(const std::vector<Point>& points,
-                                   const std::vector<Edge>& edges)
-        : points_(points), edges_(edges) {}
+    // Bits needed for the largest possible key, if it fits in 64.
+    [[nodiscard]] static auto keyBits(std::span<const Point> points)
+        -> std::optional<int> {
+        if (points.size() < 2) return std::nullopt;
+
+        const auto span = [&](auto member) -> long long {
+            const auto [lo, hi] = std::ranges::minmax(points, {}, member);
+            return std::invoke(member, hi) - std::invoke(member, lo);
+        };
+
+        constexpr long long kMaxSpan = 1LL << 30;
+        const long long dx = span(&Point::x);
+        const long long dy = span(&Point::y);
+        const long long dz = span(&Point::z);
+        if (dx >= kMaxSpan || dy >= kMaxSpan || dz >= kMaxSpan) {
+            return std::nullopt;
+        }
+
+        const auto maxDistance =
+            static_cast<std::uint64_t>(dx * dx + dy * dy + dz * dz);
+        const int bits = std::bit_width(maxDistance) +
+                         pairBitsFor(pairCount(points.size()));
+        if (bits > 64) return std::nullopt;
+        return bits;
+    }
+
+    // Distances are computed row by row over the SoA columns; rows shrink
+    // towards the end, so they go to the pool in small batches that idle
+    // workers can steal, and each row writes its own key range.
+    explicit PackedPairs(std::span<const Point> points)
+        : n_(points.size()),
+          pairBits_(pairBitsFor(pairCount(n_))),
+          keyBits_(keyBits(points).value_or(64)),
+          keys_(pairCount(n_)) {
+        const PointColumns columns(points);
+        if (n_ < 2) return;
+
+        AOC::parallelFor(0, n_ - 1, kRowsPerTask,
+                         [&](const std::size_t begin, const std::size_t end) {
+                             for (std::size_t i = begin; i < end; ++i) {
+                                 fillRow(columns, i);
+                             }
+                         });
+    }
+
+    [[nodiscard]] auto keys() noexcept -> std::vector<std::uint64_t>& {
+        return keys_;
+    }
+
+    [[nodiscard]] auto significantBits() const noexcept -> int {
+        return keyBits_;
+    }
+
+    [[nodiscard]] auto decode(const std::uint64_t key) const -> Edge {
+        const std::uint64_t pair =
+            key & ((std::uint64_t{1} << pairBits_) - 1);
 
-    [[nodiscard]] auto findTopThreeComponentsProduct(int maxEdges) const
+        // Last row whose first pair index is <= pair.
+        std::size_t lo = 0, hi = n_ - 1;
+        while (lo + 1 < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            (rowStart(mid) <= pair ? lo : hi) = mid;
+        }
+
+        const auto v = lo + 1 + (pair - rowStart(lo));
+        return {static_cast<int>(lo), static_cast<int>(v),
+                static_cast<long long>(key >> pairBits_)};
+    }
+
+private:
+    static constexpr std::size_t kRowsPerTask = 16;
+
+    std::size_t n_;
+    int pairBits_;
+    int keyBits_;
+    std::vector<std::uint64_t> keys_;
+
+    [[nodiscard]] static constexpr auto pairCount(const std::size_t n)
+        -> std::size_t {
+        return n < 2 ? 0 : n * (n - 1) / 2;
+    }
+
+    [[nodiscard]] static constexpr auto pairBitsFor(const std::size_t pairs)
+        -> int {
+        return std::max(1, static_cast<int>(std::bit_width(pairs)));
+    }
+
+    [[nodiscard]] auto rowStart(const std::size_t i) const noexcept
+        -> std::size_t {
+        return i * (2 * n_ - i - 1) / 2;
+    }
+
+    auto fillRow(const PointColumns& columns, const std::size_t i) -> void {
+        const long long xi = columns.x[i];
+        const long long yi = columns.y[i];
+        const long long zi = columns.z[i];
+        const std::size_t base = rowStart(i) - (i + 1);
+        std::uint64_t* out = keys_.data();
+
+        for (std::size_t j = i + 1; j < n_; ++j) {
+            const long long dx = columns.x[j] - xi;
+            const long long dy = columns.y[j] - yi;
+            const long long dz = columns.z[j] - zi;
+            const auto distance =
+                static_cast<std::uint64_t>(dx * dx + dy * dy + dz * dz);
+            out[base + j] = (distance << pairBits_) | (base + j);
+        }
+    }
+};
+
+// Packed pairs ordered only as far as they have been read. While reads stay
+// short, unread keys form a min-heap at the front of the buffer and each pop
+// moves the next shortest edge into a region growing from the back. Once a
+// reader goes deep enough that popping would cost more than sorting, the
+// rest of the heap is radix sorted in place and read from the front.
+class LazySortedEdges {
+public:
+    explicit LazySortedEdges(PackedPairs pairs)
+        : pairs_(std::move(pairs)), heapEnd_(pairs_.keys().size()) {
+        std::ranges::make_heap(pairs_.keys(), std::greater{});
+    }
+
+    [[nodiscard]] auto size() noexcept -> std::size_t {
+        return pairs_.keys().size();
+    }
+
+    // The i-th shortest edge (0-based); sorts just far enough to know it.
+    [[nodiscard]] auto at(const std::size_t i) -> Edge {
+        auto& keys = pairs_.keys();
+        const std::size_t popped = keys.size() - heapEnd_;
+
+        if (i < popped) return pairs_.decode(keys[keys.size() - 1 - i]);
+
+        if (!sorted_ && i >= std::max(kMinPops, keys.size() / 32)) {
+            radixSort(std::span(keys).first(heapEnd_),
+                      pairs_.significantBits());
+            sorted_ = true;
+        }
+
+        if (sorted_) return pairs_.decode(keys[i - popped]);
+
+        while (keys.size() - heapEnd_ <= i) {
+            std::pop_heap(keys.begin(), keys.begin() + heapEnd_,
+                          std::greater{});
+            --heapEnd_;
+        }
+        return pairs_.decode(keys[keys.size() - 1 - i]);
+    }
+
+private:
+    static constexpr std::size_t kMinPops = 4096;
+
+    PackedPairs pairs_;
+    std::size_t heapEnd_;
+    bool sorted_ = false;
+};
+
+// Independent read cursor over a shared LazySortedEdges.
+class LazyEdgeStream {
+public:
+    explicit LazyEdgeStream(LazySortedEdges& edges) : edges_(edges) {}
+
+    [[nodiscard]] auto next() -> std::optional<Edge> {
+        if (pos_ == edges_.size()) return std::nullopt;
+        return edges_.at(pos_++);
+    }
+
+private:
+    LazySortedEdges& edges_;
+    std::size_t pos_ = 0;
+};
+
+struct Neighbor {
+    long long distanceSquared;
+    int index;
+
+    constexpr auto operator<=>(const Neighbor&) const = default;
+};
+
+// Implicit k-d tree over an index permutation: the subtree for [lo, hi)
+// is split at mid = (lo + hi) / 2 along axis_[mid].
+class KdTree {
+public:
+    explicit KdTree(std::span<const Point> points)
+        : points_(points), order_(points.size()), axis_(points.size()) {
+        std::iota(order_.begin(), order_.end(), 0);
+        build(0, order_.size(), 0);
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return order_.size();
+    }
+
+    // The k points nearest to points[query] among those with a larger index,
+    // ordered by (distance, index). Looking only "upwards" means every pair
+    // is reported from exactly one of its endpoints.
+    auto nearestAbove(const int query, const std::size_t k,
+                      std::vector<Neighbor>& out) const -> void {
+        out.clear();
+        if (k == 0) return;
+
+        search(0, order_.size(), points_[query], query, k, out);
+        std::ranges::sort_heap(out);
+    }
+
+    // Marks every subtree with the component all of its points share, or
+    // kMixedComponent, so searches can skip whole subtrees of their own.
+    auto labelComponents(std::span<const std::uint32_t> component,
+                         std::vector<std::uint32_t>& uniform) const -> void {
+        uniform.resize(order_.size());
+        label(0, order_.size(), component, uniform);
+    }
+
+    // The shortest edge, in (distance, u, v) order, from points[query] to a
+    // point outside its component. Needs labels from labelComponents.
+    [[nodiscard]] auto nearestOutside(
+        const int query, std::span<const std::uint32_t> component,
+        std::span<const std::uint32_t> uniform) const -> std::optional<Edge> {
+        std::optional<Edge> best;
+        searchOutside(0, order_.size(), query, component, uniform, best);
+        return best;
+    }
+
+    static constexpr std::uint32_t kMixedComponent = UINT32_MAX;
+
+private:
+    static constexpr std::uint32_t kNoComponent = UINT32_MAX - 1;
+
+    std::span<const Point> points_;
+    std::vector<int> order_;
+    std::vector<std::uint8_t> axis_;
+
+    [[nodiscard]] static constexpr auto merge(const std::uint32_t a,
+                                              const std::uint32_t b) noexcept
+        -> std::uint32_t {
+        if (a == kNoComponent) return b;
+        if (b == kNoComponent) return a;
+        return a == b ? a : kMixedComponent;
+    }
+
+    auto label(const std::size_t lo, const std::size_t hi,
+               std::span<const std::uint32_t> component,
+               std::vector<std::uint32_t>& uniform) const -> std::uint32_t {
+        if (lo >= hi) return kNoComponent;
+
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const std::uint32_t left = label(lo, mid, component, uniform);
+        const std::uint32_t right = label(mid + 1, hi, component, uniform);
+
+        uniform[mid] = merge(merge(left, right), component[order_[mid]]);
+        return uniform[mid];
+    }
+
+    auto searchOutside(const std::size_t lo, const std::size_t hi,
+                       const int query,
+                       std::span<const std::uint32_t> component,
+                       std::span<const std::uint32_t> uniform,
+                       std::optional<Edge>& best) const -> void {
+        if (lo >= hi) return;
+
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (uniform[mid] == component[query]) return;
+
+        const Point& q = points_[query];
+        const int index = order_[mid];
+
+        if (component[index] != component[query]) {
+            const Edge candidate{std::min(query, index), std::max(query, index),
+                                 q.distanceSquared(points_[index])};
+            if (!best || EdgeOrder{}(candidate, *best)) best = candidate;
+        }
+
+        if (hi - lo == 1) return;
+
+        const int axis = axis_[mid];
+        const long long diff = coord(q, axis) - coord(points_[index], axis);
+        const bool goLeft = diff < 0;
+
+        if (goLeft) {
+            searchOutside(lo, mid, query, component, uniform, best);
+        } else {
+            searchOutside(mid + 1, hi, query, component, uniform, best);
+        }
+
+        if (!best || diff * diff <= best->distanceSquared) {
+            if (goLeft) {
+                searchOutside(mid + 1, hi, query, component, uniform, best);
+            } else {
+                searchOutside(lo, mid, query, component, uniform, best);
+            }
+        }
+    }
+
+    [[nodiscard]] static constexpr auto coord(const Point& p,
+                                              const int axis) noexcept
         -> long long {
-        const int n = static_cast<int>(points_.size());
-        if (n == 0) return 0;
+        return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+    }
 
-        DisjointSetUnion dsu(n);
+    auto build(const std::size_t lo, const std::size_t hi, const int depth)
+        -> void {
+        if (hi - lo <= 1) return;
+
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const int axis = depth % 3;
+
+        std::nth_element(order_.begin() + lo, order_.begin() + mid,
+                         order_.begin() + hi, [&](int a, int b) {
+                             return coord(points_[a], axis) <
+                                    coord(points_[b], axis);
+                         });
+        axis_[mid] = static_cast<std::uint8_t>(axis);
 
-        int processed = 0;
-        for (const auto& edge : edges_) {
-            if (processed >= maxEdges) break;
-            dsu.unite(edge.u, edge.v);
-            ++processed;
+        build(lo, mid, depth + 1);
+        build(mid + 1, hi, depth + 1);
+    }
+
+    // `heap` is a max-heap of the best candidates found so far.
+    auto search(const std::size_t lo, const std::size_t hi, const Point& q,
+                const int query, const std::size_t k,
+                std::vector<Neighbor>& heap) const -> void {
+        if (lo >= hi) return;
+
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const int index = order_[mid];
+
+        if (index > query) {
+            const Neighbor candidate{q.distanceSquared(points_[index]), index};
+
+            if (heap.size() < k) {
+                heap.push_back(candidate);
+                std::ranges::push_heap(heap);
+            } else if (candidate < heap.front()) {
+                std::ranges::pop_heap(heap);
+                heap.back() = candidate;
+                std::ranges::push_heap(heap);
+            }
         }
 
-        const auto componentSizes = getComponentSizes(dsu, n);
+        if (hi - lo == 1) return;
 
-        if (componentSizes.size() < 3) return 0;
+        const int axis = axis_[mid];
+        const long long diff = coord(q, axis) - coord(points_[index], axis);
+        const bool goLeft = diff < 0;
+
+        if (goLeft) {
+            search(lo, mid, q, query, k, heap);
+        } else {
+            search(mid + 1, hi, q, query, k, heap);
+        }
+
+        if (heap.size() < k || diff * diff <= heap.front().distanceSquared) {
+            if (goLeft) {
+                search(mid + 1, hi, q, query, k, heap);
+            } else {
+                search(lo, mid, q, query, k, heap);
+            }
+        }
+    }
+};
+
+// Yields every pair of points in increasing (distance, u, v) order without
+// materialising the pair list. Each point keeps a short sorted list of its
+// nearest higher-indexed neighbours, and a heap holds the next candidate of
+// every point. When a list runs out, it is re-queried with twice the k.
+class NearestEdgeStream {
+public:
+    explicit NearestEdgeStream(const KdTree& tree,
+                               const std::size_t initialK = 4)
+        : tree_(tree), cursors_(tree.size()) {
+        for (int i = 0; i < static_cast<int>(cursors_.size()); ++i) {
+            cursors_[i].k = initialK;
+            tree_.nearestAbove(i, initialK, cursors_[i].neighbors);
+            pushHead(i);
+        }
+    }
+
+    [[nodiscard]] auto next() -> std::optional<Edge> {
+        if (heads_.empty()) return std::nullopt;
+
+        std::ranges::pop_heap(heads_, LongerEdge{});
+        const Edge edge = heads_.back();
+        heads_.pop_back();
+
+        auto& cursor = cursors_[edge.u];
+        ++cursor.pos;
+
+        const auto remaining = cursors_.size() - 1 - edge.u;
+        if (cursor.pos == cursor.neighbors.size() && cursor.k < remaining) {
+            cursor.k *= 2;
+            tree_.nearestAbove(edge.u, cursor.k, cursor.neighbors);
+        }
+
+        pushHead(edge.u);
+        return edge;
+    }
+
+private:
+    struct Cursor {
+        std::vector<Neighbor> neighbors;
+        std::size_t pos = 0;
+        std::size_t k = 0;
+    };
 
-        return componentSizes[0] * componentSizes[1] * componentSizes[2];
+    const KdTree& tree_;
+    std::vector<Cursor> cursors_;
+    std::vector<Edge> heads_;
+
+    auto pushHead(const int u) -> void {
+        const auto& cursor = cursors_[u];
+        if (cursor.pos >= cursor.neighbors.size()) return;
+
+        const auto& neighbor = cursor.neighbors[cursor.pos];
+        heads_.push_back({u, neighbor.index, neighbor.distanceSquared});
+        std::ranges::push_heap(heads_, LongerEdge{});
     }
+};
 
-    [[nodiscard]] auto findLastConnectingEdgeProduct() const -> long long {
-        const int n = static_cast<int>(points_.size());
-        if (n == 0) return 0;
+// Euclidean minimum spanning tree by Boruvka rounds. In each round every
+// point finds its nearest point in another component through the k-d tree;
+// the points are split across workers. Each component then keeps its
+// shortest outgoing edge, and all of those are merged at once. Because ties
+// are broken by (distance, u, v), the tree matches Kruskal's on the sorted
+// pair list.
+class BoruvkaMst {
+public:
+    explicit BoruvkaMst(const KdTree& tree) : tree_(tree) {}
 
+    // MST edges in increasing (distance, u, v) order.
+    [[nodiscard]] auto build() const -> std::vector<Edge> {
+        const auto n = static_cast<std::uint32_t>(tree_.size());
         DisjointSetUnion dsu(n);
-        int lastU = -1, lastV = -1;
+        std::vector<Edge> mst;
+        mst.reserve(n == 0 ? 0 : n - 1);
+
+        std::vector<std::uint32_t> component(n);
+        std::vector<std::uint32_t> uniform;
+        std::vector<std::optional<Edge>> nearest(n);
+        std::vector<std::optional<Edge>> cheapest(n);
+
+        while (!dsu.isFullyConnected()) {
+            for (std::uint32_t i = 0; i < n; ++i) component[i] = dsu.find(i);
+            tree_.labelComponents(component, uniform);
+
+            AOC::parallelFor(0, n, kPointsPerTask,
+                             [&](const std::size_t begin,
+                                 const std::size_t end) {
+                                 for (auto i = begin; i < end; ++i) {
+                                     nearest[i] = tree_.nearestOutside(
+                                         static_cast<int>(i), component,
+                                         uniform);
+                                 }
+                             });
+
+            std::ranges::fill(cheapest, std::nullopt);
+            for (std::uint32_t i = 0; i < n; ++i) {
+                auto& best = cheapest[component[i]];
+                if (nearest[i] && (!best || EdgeOrder{}(*nearest[i], *best))) {
+                    best = nearest[i];
+                }
+            }
+
+            for (const auto& edge : cheapest) {
+                if (edge && dsu.unite(edge->u, edge->v)) mst.push_back(*edge);
+            }
+        }
+
+        std::ranges::sort(mst, EdgeOrder{});
+        return mst;
+    }
+
+private:
+    static constexpr std::size_t kPointsPerTask = 256;
+
+    const KdTree& tree_;
+};
 
-        for (const auto& edge : edges_) {
-            if (dsu.unite(edge.u, edge.v)) {
-                lastU = edge.u;
-                lastV = edge.v;
+// Component statistics after the first `edges` shortest edges.
+struct ConnectivitySnapshot {
+    std::size_t edges;
+    std::size_t components;
+    std::vector<std::uint32_t> largestSizes;
+};
+
+struct ConnectivitySweep {
+    std::vector<ConnectivitySnapshot> snapshots;
+    // Edges read when the last two components merged (0 for fewer than
+    // two points), if that happened before the sweep stopped.
+    std::optional<std::size_t> connectedAfter;
+};
+
+class ConstellationAnalyzer {
+public:
+    explicit ConstellationAnalyzer(std::span<const Point> points)
+        : points_(points) {}
+
+    // Answers every threshold in one Kruskal pass over `edges`, taking a
+    // snapshot of the top-k component sizes as each one is reached.
+    // Thresholds must be ascending; reading stops early once everything is
+    // connected, since later edges cannot change the components.
+    [[nodiscard]] auto sweepThresholds(EdgeSource auto edges,
+                                       std::span<const std::size_t> thresholds,
+                                       const std::size_t topK) const
+        -> ConnectivitySweep {
+        if (!std::ranges::is_sorted(thresholds)) {
+            throw std::invalid_argument("thresholds must be ascending");
+        }
+
+        DisjointSetUnion dsu(static_cast<std::uint32_t>(points_.size()));
+        ConnectivitySweep sweep;
+        sweep.snapshots.reserve(thresholds.size());
+        if (dsu.isFullyConnected()) sweep.connectedAfter = 0;
+
+        std::size_t read = 0;
+        bool exhausted = false;
 
-                if (isFullyConnected(dsu, n)) {
+        for (const std::size_t threshold : thresholds) {
+            while (read < threshold && !exhausted &&
+                   !dsu.isFullyConnected()) {
+                const auto edge = edges.next();
+                if (!edge) {
+                    exhausted = true;
                     break;
                 }
+
+                ++read;
+                if (dsu.unite(edge->u, edge->v) && dsu.isFullyConnected()) {
+                    sweep.connectedAfter = read;
+                }
             }
+
+            sweep.snapshots.push_back({threshold, dsu.countComponents(),
+                                       dsu.largestSizes(topK)});
+        }
+
+        return sweep;
+    }
+
+    [[nodiscard]] auto findTopThreeComponentsProduct(
+        EdgeSource auto edges, const std::size_t maxEdges) const -> long long {
+        if (points_.empty()) return 0;
+
+        const std::array thresholds{maxEdges};
+        const auto sweep = sweepThresholds(std::move(edges), thresholds, 3);
+        const auto& componentSizes = sweep.snapshots.front().largestSizes;
+
+        if (componentSizes.size() < 3) return 0;
+
+        return static_cast<long long>(componentSizes[0]) * componentSizes[1] *
+               componentSizes[2];
+    }
+
+    // Kruskal: the edges that joined two components, in the order read.
+    // With edges in (distance, u, v) order this is the MST BoruvkaMst
+    // builds, and the differential suite checks that it is.
+    [[nodiscard]] auto spanningTree(EdgeSource auto edges) const
+        -> std::vector<Edge> {
+        DisjointSetUnion dsu(static_cast<std::uint32_t>(points_.size()));
+        std::vector<Edge> tree;
+
+        while (!dsu.isFullyConnected()) {
+            const auto edge = edges.next();
+            if (!edge) break;
+            if (dsu.unite(edge->u, edge->v)) tree.push_back(*edge);
         }
 
-        if (lastU == -1 || lastV == -1) return 0;
+        return tree;
+    }
+
+    [[nodiscard]] auto findLastConnectingEdgeProduct(
+        EdgeSource auto edges) const -> long long {
+        const auto tree = spanningTree(std::move(edges));
+        if (tree.empty()) return 0;
 
-        return points_[lastU].x * points_[lastV].x;
+        return points_[tree.back().u].x * points_[tree.back().v].x;
     }
 
 private:
-    const std::vector<Point>& points_;
-    const std::vector<Edge>& edges_;
+    std::span<const Point> points_;
+};
 
-    [[nodiscard]] static auto getComponentSizes(
-        const DisjointSetUnion<int>& dsu, int n) -> std::vector<long long> {
-        std::map<int, long long> componentMap;
+// Small constellations sort the full pair list; larger ones, or ones whose
+// pairs cannot be packed into 64-bit keys, stream candidate edges from a
+// spatial index instead of building O(n^2) pairs.
+enum class EdgeMode { AllPairs, Spatial };
 
-        for (int i = 0; i < n; ++i) {
-            componentMap[const_cast<DisjointSetUnion<int>&>(dsu).find(i)]++;
-        }
+inline constexpr std::size_t kAllPairsLimit = 4096;
 
-        auto sizes =
-            componentMap | std::views::values | std::ranges::to<std::vector>();
+[[nodiscard]] inline auto selectEdgeMode(std::span<const Point> points)
+    -> EdgeMode {
+    return points.size() <= kAllPairsLimit && PackedPairs::keyBits(points)
+               ? EdgeMode::AllPairs
+               : EdgeMode::Spatial;
+}
 
-        std::ranges::sort(sizes, std::greater<>{});
-        return sizes;
+// Parsed once and shared by both parts. The points are viewed, not owned:
+// main keeps them in their snapshot mapping. In AllPairs mode the pair list
+// is generated on first use and its lazily sorted prefix is reused by later
+// readers.
+class Constellation {
+public:
+    explicit Constellation(std::span<const Point> points)
+        : points_(points), mode_(selectEdgeMode(points_)) {}
+
+    [[nodiscard]] auto points() const noexcept -> std::span<const Point> {
+        return points_;
     }
 
-    [[nodiscard]] static auto isFullyConnected(DisjointSetUnion<int>& dsu,
-                                               int n) -> bool {
-        int root = dsu.find(0);
-        return std::ranges::all_of(std::views::iota(1, n), [&dsu, root](int i) {
-            return dsu.find(i) == root;
-        });
+    // Calls fn with an EdgeSource yielding edges in increasing length.
+    template <typename Fn>
+    [[nodiscard]] auto withEdges(Fn&& fn) const -> long long {
+        if (mode_ == EdgeMode::AllPairs) {
+            if (!pairs_) pairs_.emplace(PackedPairs(points_));
+            return fn(LazyEdgeStream(*pairs_));
+        }
+
+        const KdTree tree(points_);
+        return fn(NearestEdgeStream(tree));
     }
+
+private:
+    std::span<const Point> points_;
+    EdgeMode mode_;
+    mutable std::optional<LazySortedEdges> pairs_;
 };
 
 template <typename Derived>
 class SolutionStrategy {
 public:
-    explicit SolutionStrategy(const std::vector<std::string>& input)
-        : points_(std::get<0>(InputParser::parse(input))),
-          edges_(std::get<1>(InputParser::parse(input))) {}
+    explicit SolutionStrategy(const Constellation& constellation)
+        : constellation_(constellation) {}
 
     [[nodiscard]] auto solve() const -> long long {
         return static_cast<const Derived*>(this)->solveImpl();
     }
 
 protected:
-    std::vector<Point> points_;
-    std::vector<Edge> edges_;
+    const Constellation& constellation_;
 };
 
+inline constexpr std::size_t kPart1Connections = 1000;
+
 class Part1Solution : public SolutionStrategy<Part1Solution> {
 public:
-    using SolutionStrategy<Part1Solution>::SolutionStrategy;
+    explicit Part1Solution(const Constellation& constellation,
+                           const std::size_t connections = kPart1Connections)
+        : SolutionStrategy(constellation), connections_(connections) {}
 
     [[nodiscard]] auto solveImpl() const -> long long {
-        ConstellationAnalyzer analyzer(points_, edges_);
-        return analyzer.findTopThreeComponentsProduct(1000);
+        ConstellationAnalyzer analyzer(constellation_.points());
+        return constellation_.withEdges([&](auto edges) {
+            return analyzer.findTopThreeComponentsProduct(std::move(edges),
+                                                          connections_);
+        });
     }
+
+private:
+    std::size_t connections_;
 };
 
 class Part2Solution : public SolutionStrategy<Part2Solution> {
 public:
     using SolutionStrategy<Part2Solution>::SolutionStrategy;
 
+    // The edge that finally connects everything is the longest MST edge.
     [[nodiscard]] auto solveImpl() const -> long long {
-        ConstellationAnalyzer analyzer(points_, edges_);
-        return analyzer.findLastConnectingEdgeProduct();
+        const auto points = constellation_.points();
+        const KdTree tree(points);
+        const auto mst = BoruvkaMst(tree).build();
+
+        if (mst.empty()) return 0;
+
+        return points[mst.back().u].x * points[mst.back().v].x;
+    }
+};
+
+[[nodiscard]] inline auto part1(const Constellation& constellation)
+    -> long long {
+    return Part1Solution(constellation).solve();
+}
+
+[[nodiscard]] inline auto part2(const Constellation& constellation)
+    -> long long {
+    return Part2Solution(constellation).solve();
+}
+
+// The pair list as the original solution built it: every pair in one
+// vector, fully sorted up front. The reference edge order for the
+// differential suite.
+class SortedEdgeList {
+public:
+    explicit SortedEdgeList(std::span<const Point> points) {
+        const int n = static_cast<int>(points.size());
+        for (int u = 0; u < n; ++u) {
+            for (int v = u + 1; v < n; ++v) {
+                edges_.push_back({u, v, points[u].distanceSquared(points[v])});
+            }
+        }
+        std::ranges::sort(edges_, EdgeOrder{});
+    }
+
+    [[nodiscard]] auto next() -> std::optional<Edge> {
+        if (pos_ == edges_.size()) return std::nullopt;
+        return edges_[pos_++];
     }
+
+private:
+    std::vector<Edge> edges_;
+    std::size_t pos_ = 0;
 };
 
-[[nodiscard]] inline auto part1(const std::vector<std::string>& input)
+// Part 1 straight from the rules: join the first `connections` pairs, then
+// count every point's root and multiply the three largest counts.
+[[nodiscard]] inline auto referencePart1(std::span<const Point> points,
+                                         const std::size_t connections)
     -> long long {
-    return Part1Solution(input).solve();
+    const auto n = static_cast<std::uint32_t>(points.size());
+    DisjointSetUnion dsu(n);
+    SortedEdgeList edges(points);
+
+    for (std::size_t i = 0; i < connections; ++i) {
+        const auto edge = edges.next();
+        if (!edge) break;
+        dsu.unite(edge->u, edge->v);
+    }
+
+    std::vector<long long> sizes(n);
+    for (std::uint32_t i = 0; i < n; ++i) ++sizes[dsu.find(i)];
+    std::ranges::sort(sizes, std::greater<>{});
+
+    if (n < 3 || sizes[2] == 0) return 0;
+    return sizes[0] * sizes[1] * sizes[2];
 }
 
-[[nodiscard]] inline auto part2(const std::vector<std::string>& input)
+// Folds (u, v, distance) of each edge in order into one value, so whole
+// trees can be compared.
+[[nodiscard]] inline auto foldEdges(std::span<const Edge> edges) -> long long {
+    std::uint64_t folded = edges.size();
+    for (const auto& [u, v, distanceSquared] : edges) {
+        for (const auto value : {static_cast<long long>(u),
+                                 static_cast<long long>(v), distanceSquared}) {
+            folded = folded * 1'000'003 + static_cast<std::uint64_t>(value);
+        }
+    }
+    return static_cast<long long>(folded);
+}
+
+// Several thresholds from none to every pair, answered by one sweep (the
+// optimized variant) or by a fresh sweep each (the reference).
+[[nodiscard]] inline auto sweepThresholdsFor(const std::size_t n)
+    -> std::vector<std::size_t> {
+    std::vector<std::size_t> thresholds{0, 1, n / 2, n, 2 * n,
+                                        n * (n - 1) / 2 + 1};
+    std::ranges::sort(thresholds);
+    return thresholds;
+}
+
+[[nodiscard]] inline auto foldSweep(const ConnectivitySweep& sweep)
     -> long long {
-    return Part2Solution(input).solve();
+    std::uint64_t folded = sweep.connectedAfter.value_or(SIZE_MAX);
+    for (const auto& [edges, components, largestSizes] : sweep.snapshots) {
+        folded = folded * 1'000'003 + edges;
+        folded = folded * 1'000'003 + components;
+        for (const auto size : largestSizes) {
+            folded = folded * 1'000'003 + size;
+        }
+    }
+    return static_cast<long long>(folded);
+}
+
+// Small coordinate ranges make equal distances common, so the (distance,
+// u, v) tie-break is exercised; part 1 joins as many pairs as there are
+// points.
+[[nodiscard]] inline auto differentialSuite()
+    -> AOC::DifferentialSuite<std::vector<Point>> {
+    using Points = std::vector<Point>;
+
+    AOC::DifferentialSuite<Points> suite(
+        [](std::mt19937_64& rng, const std::size_t size) {
+            constexpr std::array kRanges{3LL, 20LL, 100000LL};
+            const long long range =
+                kRanges[std::uniform_int_distribution<std::size_t>(
+                    0, kRanges.size() - 1)(rng)];
+            std::uniform_int_distribution<long long> coordinate(0, range);
+
+            Points points(size);
+            for (auto& [x, y, z] : points) {
+                x = coordinate(rng);
+                y = coordinate(rng);
+                z = coordinate(rng);
+            }
+            return points;
+        },
+        [](const Points& points) {
+            std::vector<Points> smaller;
+            for (std::size_t i = 0; points.size() > 1 && i < points.size();
+                 ++i) {
+                auto without = points;
+                without.erase(without.begin() + static_cast<long>(i));
+                smaller.push_back(std::move(without));
+            }
+            return smaller;
+        },
+        [](const Points& points) {
+            std::string text;
+            for (const auto& [x, y, z] : points) {
+                text += std::format("{},{},{}\n", x, y, z);
+            }
+            text.pop_back();
+            return text;
+        });
+
+    suite.add(
+        "part1",
+        [](const Points& points) {
+            return referencePart1(points, points.size());
+        },
+        [](const Points& points) {
+            return Part1Solution(Constellation(points), points.size())
+                .solve();
+        });
+    suite.add(
+        "part1 k-d tree",
+        [](const Points& points) {
+            return referencePart1(points, points.size());
+        },
+        [](const Points& points) {
+            const KdTree tree(points);
+            return ConstellationAnalyzer(points).findTopThreeComponentsProduct(
+                NearestEdgeStream(tree), points.size());
+        });
+    suite.add(
+        "part2",
+        [](const Points& points) {
+            return ConstellationAnalyzer(points).findLastConnectingEdgeProduct(
+                SortedEdgeList(points));
+        },
+        [](const Points& points) {
+            return Part2Solution(Constellation(points)).solve();
+        });
+    suite.add(
+        "mst edges",
+        [](const Points& points) {
+            return foldEdges(ConstellationAnalyzer(points).spanningTree(
+                SortedEdgeList(points)));
+        },
+        [](const Points& points) {
+            const KdTree tree(points);
+            return foldEdges(BoruvkaMst(tree).build());
+        });
+    suite.add(
+        "thresholds",
+        [](const Points& points) {
+            const ConstellationAnalyzer analyzer(points);
+            ConnectivitySweep sweep;
+            for (const auto threshold : sweepThresholdsFor(points.size())) {
+                const std::array single{threshold};
+                auto one = analyzer.sweepThresholds(SortedEdgeList(points),
+                                                    single, 3);
+                sweep.snapshots.push_back(std::move(one.snapshots.front()));
+                sweep.connectedAfter = one.connectedAfter;
+            }
+            return foldSweep(sweep);
+        },
+        [](const Points& points) {
+            const KdTree tree(points);
+            return foldSweep(ConstellationAnalyzer(points).sweepThresholds(
+                NearestEdgeStream(tree), sweepThresholdsFor(points.size()),
+                3));
+        });
+    return suite;
 }
 
-int main() {
+// Bump whenever Point or InputParser changes, so stale snapshots are
+// ignored.
+inline constexpr std::uint32_t kSnapshotVersion = 1;
+
+int main(int argc, char* argv[]) {
     try {
-        const std::vector<std::string> input =
-            AOC::fetchAOCInputVector(2025, 8);
+        if (const auto options =
+                AOC::DifferentialOptions::fromArgs(argc, argv)) {
+            return differentialSuite().run(*options);
+        }
 
-        std::string part1_ans = std::to_string(part1(input));
-        std::string part2_ans = std::to_string(part2(input));
+        AOC::Runner runner(2025, 8, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
+        const std::string input = runner.rawInput();
+        const auto parse = [&] {
+            return InputParser::parsePoints(AOC::splitLines(input));
+        };
+        const auto points = runner.phase("parse", [&] {
+            return AOC::loadOrParse<Point>(runner.snapshotPath("points"),
+                                           kSnapshotVersion, input, parse);
+        });
+        const Constellation constellation(points.view());
 
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
+        runner.answer(1, runner.phase("part1",
+                                      [&] { return part1(constellation); }));
+        runner.answer(2, runner.phase("part2",
+                                      [&] { return part2(constellation); }));
 
-        AOC::submitAnswer(2025, 8, 1, part1_ans);
-        AOC::submitAnswer(2025, 8, 2, part2_ans);
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
-}
\ No newline at end of file
+}
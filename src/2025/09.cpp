@@ -1,13 +1,25 @@
 #include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <print>
+#include <random>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "AOC.hpp"
+#include "Differential.hpp"
+#include "Embedded.hpp"
+#include "Parallel.hpp"
+#include "Runner.hpp"
+#include "Snapshot.hpp"
 
 template <typename T>
 concept Numeric = std::integral<T> || std::floating_point<T>;
@@ -110,17 +122,352 @@ private:
     }
 };
 
+// Splits a sorted, deduplicated coordinate list into cells: cell 2k+1 is
+// the line coords[k] and cell 2k is the open gap before it, so there are
+// 2 * coords.size() + 1 cells in all.
+template <Numeric T>
+[[nodiscard]] auto coordinateCell(const std::vector<T>& coords, T value)
+    -> std::size_t {
+    const auto it = std::ranges::lower_bound(coords, value);
+    const auto k = static_cast<std::size_t>(it - coords.begin());
+    return (it != coords.end() && *it == value) ? 2 * k + 1 : 2 * k;
+}
+
+// Exact inside/outside oracle for a rectilinear polygon with integral
+// vertices. The plane is cut at every vertex coordinate into a grid of
+// cells: one cell per coordinate line plus one per open gap between
+// neighbouring coordinates (and an unbounded gap on either end). Boundary
+// segments only ever lie on coordinate lines, so every other cell is wholly
+// inside or wholly outside; a flood fill from the unbounded border finds the
+// outside ones. A 2D prefix sum over outside cells that hold at least one
+// lattice point then answers "is every tile of this rectangle red or
+// green?" in O(1).
+template <std::integral T = long long>
+class CompressedPolygon {
+public:
+    // Returns nullopt unless every edge is horizontal or vertical.
+    [[nodiscard]] static auto build(std::span<const Point<T>> polygon)
+        -> std::optional<CompressedPolygon> {
+        const std::size_t n = polygon.size();
+        if (n < 3) return std::nullopt;
+
+        for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+            if (polygon[i].x != polygon[j].x && polygon[i].y != polygon[j].y) {
+                return std::nullopt;
+            }
+        }
+
+        return CompressedPolygon(polygon);
+    }
+
+    // Whether the rectangle spanned by vertices i and j lies in the polygon.
+    [[nodiscard]] auto containsSpan(std::size_t i, std::size_t j) const
+        -> bool {
+        const auto [c0, c1] = std::minmax(vertexCols_[i], vertexCols_[j]);
+        const auto [r0, r1] = std::minmax(vertexRows_[i], vertexRows_[j]);
+        return outsideIn(c0, r0, c1, r1) == 0;
+    }
+
+private:
+    std::vector<T> xs_;
+    std::vector<T> ys_;
+    std::size_t cols_ = 0;
+    std::size_t rows_ = 0;
+    std::vector<std::size_t> vertexCols_;
+    std::vector<std::size_t> vertexRows_;
+    // (cols_ + 1) x (rows_ + 1) inclusive prefix sums of outside cells.
+    std::vector<std::uint32_t> outsidePrefix_;
+
+    explicit CompressedPolygon(std::span<const Point<T>> polygon) {
+        xs_ = sortedCoordinates(polygon, &Point<T>::x);
+        ys_ = sortedCoordinates(polygon, &Point<T>::y);
+        cols_ = 2 * xs_.size() + 1;
+        rows_ = 2 * ys_.size() + 1;
+
+        vertexCols_.reserve(polygon.size());
+        vertexRows_.reserve(polygon.size());
+        for (const auto& p : polygon) {
+            vertexCols_.push_back(coordinateCell(xs_, p.x));
+            vertexRows_.push_back(coordinateCell(ys_, p.y));
+        }
+
+        std::vector<std::uint8_t> state(cols_ * rows_, kUnknown);
+        markBoundary(state);
+        floodOutside(state);
+        buildPrefix(state);
+    }
+
+    static constexpr std::uint8_t kUnknown = 0;
+    static constexpr std::uint8_t kBoundary = 1;
+    static constexpr std::uint8_t kOutside = 2;
+
+    [[nodiscard]] static auto sortedCoordinates(
+        std::span<const Point<T>> polygon, T Point<T>::*axis)
+        -> std::vector<T> {
+        auto coords = polygon |
+                      std::views::transform([axis](const auto& p) {
+                          return p.*axis;
+                      }) |
+                      std::ranges::to<std::vector>();
+        std::ranges::sort(coords);
+        const auto [first, last] = std::ranges::unique(coords);
+        coords.erase(first, last);
+        return coords;
+    }
+
+    // Even (gap) cells between two adjacent integers hold no tiles.
+    [[nodiscard]] static auto hasLattice(const std::vector<T>& coords,
+                                         std::size_t cell) -> bool {
+        if (cell % 2 == 1 || cell == 0 || cell == 2 * coords.size()) {
+            return true;
+        }
+        const std::size_t k = cell / 2;
+        return coords[k] - coords[k - 1] > 1;
+    }
+
+    [[nodiscard]] auto index(std::size_t col, std::size_t row) const
+        -> std::size_t {
+        return row * cols_ + col;
+    }
+
+    auto markBoundary(std::vector<std::uint8_t>& state) const -> void {
+        const std::size_t n = vertexCols_.size();
+
+        for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+            const auto [c0, c1] = std::minmax(vertexCols_[i], vertexCols_[j]);
+            const auto [r0, r1] = std::minmax(vertexRows_[i], vertexRows_[j]);
+
+            for (std::size_t r = r0; r <= r1; ++r) {
+                for (std::size_t c = c0; c <= c1; ++c) {
+                    state[index(c, r)] = kBoundary;
+                }
+            }
+        }
+    }
+
+    auto floodOutside(std::vector<std::uint8_t>& state) const -> void {
+        // Cell (0, 0) is an unbounded gap, so it is always outside.
+        std::vector<std::size_t> stack{index(0, 0)};
+        state[index(0, 0)] = kOutside;
+
+        const auto visit = [&](std::size_t cell) {
+            if (state[cell] == kUnknown) {
+                state[cell] = kOutside;
+                stack.push_back(cell);
+            }
+        };
+
+        while (!stack.empty()) {
+            const std::size_t cell = stack.back();
+            stack.pop_back();
+
+            const std::size_t col = cell % cols_;
+            const std::size_t row = cell / cols_;
+
+            if (col > 0) visit(cell - 1);
+            if (col + 1 < cols_) visit(cell + 1);
+            if (row > 0) visit(cell - cols_);
+            if (row + 1 < rows_) visit(cell + cols_);
+        }
+    }
+
+    auto buildPrefix(const std::vector<std::uint8_t>& state) -> void {
+        const std::size_t stride = cols_ + 1;
+        outsidePrefix_.assign(stride * (rows_ + 1), 0);
+
+        for (std::size_t r = 0; r < rows_; ++r) {
+            const bool rowHasLattice = hasLattice(ys_, r);
+
+            for (std::size_t c = 0; c < cols_; ++c) {
+                const bool outside = state[index(c, r)] == kOutside &&
+                                     rowHasLattice && hasLattice(xs_, c);
+
+                outsidePrefix_[(r + 1) * stride + c + 1] =
+                    static_cast<std::uint32_t>(outside) +
+                    outsidePrefix_[r * stride + c + 1] +
+                    outsidePrefix_[(r + 1) * stride + c] -
+                    outsidePrefix_[r * stride + c];
+            }
+        }
+    }
+
+    [[nodiscard]] auto outsideIn(std::size_t c0, std::size_t r0,
+                                 std::size_t c1, std::size_t r1) const
+        -> std::uint32_t {
+        const std::size_t stride = cols_ + 1;
+        return outsidePrefix_[(r1 + 1) * stride + c1 + 1] -
+               outsidePrefix_[r0 * stride + c1 + 1] -
+               outsidePrefix_[(r1 + 1) * stride + c0] +
+               outsidePrefix_[r0 * stride + c0];
+    }
+};
+
+// Point-in-polygon index that agrees exactly with the linear ray cast
+// (boundary counts as inside; crossings use the same truncating division).
+// Edges are bucketed into the y cells of coordinateCell. Within a cell the
+// vertical edges are kept as sorted x lists and horizontal edges as sorted
+// x spans, so a query on a rectilinear polygon is a handful of binary
+// searches. Sloped edges fall back to the direct test but only within
+// their own cells. Assumes a simple polygon, whose horizontal edges on one
+// line never overlap.
+template <Numeric T = long long>
+class PolygonIndex {
+public:
+    explicit PolygonIndex(std::span<const Point<T>> polygon)
+        : polygon_(polygon) {
+        ys_ = polygon | std::views::transform(&Point<T>::y) |
+              std::ranges::to<std::vector>();
+        std::ranges::sort(ys_);
+        const auto [first, last] = std::ranges::unique(ys_);
+        ys_.erase(first, last);
+        cells_.resize(2 * ys_.size() + 1);
+
+        const std::size_t n = polygon.size();
+        for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+            addEdge(i, j);
+        }
+
+        for (auto& cell : cells_) {
+            std::ranges::sort(cell.crossingX);
+            std::ranges::sort(cell.touchingX);
+            std::ranges::sort(cell.horizontal, {}, &Span::from);
+        }
+    }
+
+    [[nodiscard]] auto contains(Point<T> p) const -> bool {
+        if (cells_.empty()) return false;
+
+        const Cell& cell = cells_[coordinateCell(ys_, p.y)];
+
+        if (std::ranges::binary_search(cell.touchingX, p.x)) return true;
+
+        const auto span = std::ranges::upper_bound(cell.horizontal, p.x, {},
+                                                   &Span::from);
+        if (span != cell.horizontal.begin() && p.x <= std::prev(span)->to) {
+            return true;
+        }
+
+        bool inside = (cell.crossingX.end() -
+                       std::ranges::upper_bound(cell.crossingX, p.x)) %
+                          2 ==
+                      1;
+
+        for (const std::size_t i : cell.sloped) {
+            const auto& pi = polygon_[i];
+            const auto& pj = polygon_[i == 0 ? polygon_.size() - 1 : i - 1];
+
+            if (isPointOnSegment(p, pj, pi)) return true;
+
+            if (((pi.y > p.y) != (pj.y > p.y)) &&
+                (p.x < (pj.x - pi.x) * (p.y - pi.y) / (pj.y - pi.y) + pi.x)) {
+                inside = !inside;
+            }
+        }
+
+        return inside;
+    }
+
+    // One flag per query point. Queries are independent, so a large batch
+    // can be split across threads.
+    [[nodiscard]] auto containsAll(std::span<const Point<T>> points,
+                                   bool parallel = false) const
+        -> std::vector<std::uint8_t> {
+        std::vector<std::uint8_t> inside(points.size());
+
+        const auto query = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; ++k) {
+                inside[k] = contains(points[k]) ? 1 : 0;
+            }
+        };
+
+        if (parallel) {
+            AOC::parallelFor(0, points.size(), kQueriesPerTask, query);
+        } else {
+            query(0, points.size());
+        }
+
+        return inside;
+    }
+
+private:
+    struct Span {
+        T from;
+        T to;
+    };
+
+    struct Cell {
+        // Vertical edges the ray test counts for any y in this cell.
+        std::vector<T> crossingX;
+        // Vertical edges with any point in this cell.
+        std::vector<T> touchingX;
+        std::vector<Span> horizontal;
+        // Index i of sloped edges (polygon[i - 1], polygon[i]).
+        std::vector<std::size_t> sloped;
+    };
+
+    static constexpr std::size_t kQueriesPerTask = 4096;
+
+    std::span<const Point<T>> polygon_;
+    std::vector<T> ys_;
+    std::vector<Cell> cells_;
+
+    auto addEdge(std::size_t i, std::size_t j) -> void {
+        const auto& pi = polygon_[i];
+        const auto& pj = polygon_[j];
+
+        const std::size_t lo = coordinateCell(ys_, std::min(pi.y, pj.y));
+        const std::size_t hi = coordinateCell(ys_, std::max(pi.y, pj.y));
+
+        if (pi.y == pj.y) {
+            cells_[lo].horizontal.push_back(
+                {std::min(pi.x, pj.x), std::max(pi.x, pj.x)});
+            return;
+        }
+
+        for (std::size_t c = lo; c <= hi; ++c) {
+            if (pi.x != pj.x) {
+                cells_[c].sloped.push_back(i);
+                continue;
+            }
+
+            cells_[c].touchingX.push_back(pi.x);
+            // The ray test counts min(y) <= p.y < max(y), so the line
+            // through the top endpoint is touched but not crossed.
+            if (c != hi) cells_[c].crossingX.push_back(pi.x);
+        }
+    }
+
+    [[nodiscard]] static auto isPointOnSegment(Point<T> p, Point<T> a,
+                                               Point<T> b) -> bool {
+        T crossProduct = (p.y - a.y) * (b.x - a.x) - (p.x - a.x) * (b.y - a.y);
+        if (crossProduct != 0) return false;
+
+        if (p.x < std::min(a.x, b.x) || p.x > std::max(a.x, b.x)) return false;
+        if (p.y < std::min(a.y, b.y) || p.y > std::max(a.y, b.y)) return false;
+
+        return true;
+    }
+};
+
+// Auto scans exhaustively when the validity check is O(1) and goes
+// largest-area first when it is expensive.
+enum class SearchMode { Auto, Exhaustive, AreaDescending };
+
 template <Numeric T = long long>
 class RectangleFinder {
 public:
-    explicit RectangleFinder(const std::vector<Point<T>>& points)
-        : points_(points) {}
+    explicit RectangleFinder(std::span<const Point<T>> points,
+                             SearchMode mode = SearchMode::Auto)
+        : points_(points), mode_(mode) {}
 
     [[nodiscard]] auto findLargestRectangle() const -> T {
         if (points_.size() < 2) {
             return T{0};
         }
-        return findMaxAreaBruteForce();
+        if (mode_ == SearchMode::Exhaustive) {
+            return findMaxAreaBruteForce();
+        }
+        return findMaxAreaOnStaircases();
     }
 
     [[nodiscard]] auto findLargestRectangleInsidePolygon() const -> T {
@@ -130,8 +477,26 @@ public:
         return findMaxAreaWithPolygonConstraint();
     }
 
+    // The fallback of findLargestRectangleInsidePolygon, run directly. It
+    // samples every side, so it is exact only while sides span fewer than
+    // 200 tiles and no part of the polygon is a single tile wide.
+    [[nodiscard]] auto findLargestRectangleBySampling() const -> T {
+        if (points_.size() < 3) {
+            return T{0};
+        }
+
+        const PolygonIndex<T> polygon(points_);
+        return findMaxValidArea(
+            [&](std::size_t i, std::size_t j) {
+                return isRectangleValid(Rect<T>(points_[i], points_[j]),
+                                        polygon);
+            },
+            SearchMode::AreaDescending);
+    }
+
 private:
-    const std::vector<Point<T>>& points_;
+    std::span<const Point<T>> points_;
+    SearchMode mode_;
 
     [[nodiscard]] auto findMaxAreaBruteForce() const -> T {
         const std::size_t n = points_.size();
@@ -147,46 +512,120 @@ private:
         return maxArea;
     }
 
-    [[nodiscard]] auto isPointInPolygon(Point<T> p) const -> bool {
-        const std::size_t n = points_.size();
-        bool inside = false;
+    // Pareto-minimal points ("lower-left staircase") of points sorted
+    // ascending, x ascending and y strictly descending.
+    [[nodiscard]] static auto lowerStaircase(std::span<const Point<T>> sorted)
+        -> std::vector<Point<T>> {
+        std::vector<Point<T>> stairs;
 
-        for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
-            const auto& pi = points_[i];
-            const auto& pj = points_[j];
+        for (const auto& p : sorted) {
+            if (stairs.empty() || p.y < stairs.back().y) {
+                stairs.push_back(p);
+            }
+        }
 
-            if (isPointOnSegment(p, pj, pi)) {
-                return true;
+        return stairs;
+    }
+
+    // Pareto-maximal points ("upper-right staircase") of points sorted
+    // ascending, in the same order as lowerStaircase.
+    [[nodiscard]] static auto upperStaircase(std::span<const Point<T>> sorted)
+        -> std::vector<Point<T>> {
+        std::vector<Point<T>> stairs;
+
+        for (const auto& p : sorted | std::views::reverse) {
+            if (stairs.empty() || p.y > stairs.back().y) {
+                stairs.push_back(p);
             }
+        }
 
-            if (((pi.y > p.y) != (pj.y > p.y)) &&
-                (p.x < (pj.x - pi.x) * (p.y - pi.y) / (pj.y - pi.y) + pi.x)) {
-                inside = !inside;
+        std::ranges::reverse(stairs);
+        return stairs;
+    }
+
+    // Largest rectangle with a lower-left corner from `lower` and an
+    // upper-right corner from `upper`. The best partner index is monotone
+    // in the lower corner's index, so divide and conquer over the lower
+    // staircase needs O((|lower| + |upper|) log |lower|) evaluations.
+    [[nodiscard]] static auto maxDominatingArea(
+        std::span<const Point<T>> lower, std::span<const Point<T>> upper,
+        std::size_t optLo, std::size_t optHi) -> std::optional<T> {
+        if (lower.empty()) return std::nullopt;
+
+        const std::size_t mid = lower.size() / 2;
+        const Point<T> p = lower[mid];
+
+        std::optional<T> best;
+        std::size_t bestIndex = optLo;
+
+        for (std::size_t k = optLo; k <= optHi; ++k) {
+            // Shifting the upper corner by one turns the inclusive area
+            // into a plain product; pairs behind p on both axes would
+            // yield a spurious positive product, so they never count.
+            const T dx = upper[k].x + 1 - p.x;
+            const T dy = upper[k].y + 1 - p.y;
+            if (dx < T{0} && dy < T{0}) continue;
+
+            if (!best || dx * dy > *best) {
+                best = dx * dy;
+                bestIndex = k;
             }
         }
 
-        return inside;
+        const auto merge = [](std::optional<T> a, std::optional<T> b) {
+            if (!a) return b;
+            if (!b) return a;
+            return std::optional<T>(std::max(*a, *b));
+        };
+
+        best = merge(best, maxDominatingArea(lower.first(mid), upper, optLo,
+                                             bestIndex));
+        return merge(best, maxDominatingArea(lower.subspan(mid + 1), upper,
+                                             bestIndex, optHi));
     }
 
-    [[nodiscard]] static auto isPointOnSegment(Point<T> p, Point<T> a,
-                                               Point<T> b) -> bool {
-        T crossProduct = (p.y - a.y) * (b.x - a.x) - (p.x - a.x) * (b.y - a.y);
-        if (crossProduct != 0) return false;
+    // Every pair spans its rectangle along one of the two diagonals. For
+    // the main diagonal the best corners lie on the lower-left and
+    // upper-right staircases; mirroring y turns the anti-diagonal into the
+    // same problem. The two orientations run as separate pool tasks.
+    [[nodiscard]] auto findMaxAreaOnStaircases() const -> T {
+        const auto orientationArea = [](std::vector<Point<T>> points) {
+            std::ranges::sort(points);
+            const auto lower = lowerStaircase(points);
+            const auto upper = upperStaircase(points);
+            return maxDominatingArea(lower, upper, 0, upper.size() - 1)
+                .value_or(T{0});
+        };
 
-        if (p.x < std::min(a.x, b.x) || p.x > std::max(a.x, b.x)) return false;
-        if (p.y < std::min(a.y, b.y) || p.y > std::max(a.y, b.y)) return false;
+        std::vector<Point<T>> points(points_.begin(), points_.end());
+        std::vector<Point<T>> mirrored = points;
+        for (auto& p : mirrored) p.y = -p.y;
 
-        return true;
+        T mainArea = T{0};
+        T antiArea = T{0};
+        AOC::parallelInvoke(
+            [&] { mainArea = orientationArea(std::move(points)); },
+            [&] { antiArea = orientationArea(std::move(mirrored)); });
+
+        return std::max(mainArea, antiArea);
     }
 
-    [[nodiscard]] auto isRectangleValid(const Rect<T>& rect) const -> bool {
+    // Samples the corners first, then about 100 points per side and the
+    // centre, each set as one batched index query.
+    [[nodiscard]] static auto isRectangleValid(const Rect<T>& rect,
+                                               const PolygonIndex<T>& polygon)
+        -> bool {
+        const auto allInside = [&](const std::vector<Point<T>>& samples) {
+            return std::ranges::all_of(polygon.containsAll(samples),
+                                       [](std::uint8_t in) { return in; });
+        };
+
         Point<T> topLeft = rect.topLeft();
         Point<T> bottomRight = rect.bottomRight();
         Point<T> topRight = {bottomRight.x, topLeft.y};
         Point<T> bottomLeft = {topLeft.x, bottomRight.y};
 
-        if (!isPointInPolygon(topLeft) || !isPointInPolygon(topRight) ||
-            !isPointInPolygon(bottomLeft) || !isPointInPolygon(bottomRight)) {
+        if (!allInside({topLeft, topRight, bottomLeft, bottomRight})) {
             return false;
         }
 
@@ -196,63 +635,149 @@ private:
         T stepX = std::max(T{1}, width / 100);
         T stepY = std::max(T{1}, height / 100);
 
+        std::vector<Point<T>> samples;
         for (T x = topLeft.x; x <= bottomRight.x; x += stepX) {
-            if (!isPointInPolygon({x, topLeft.y}) ||
-                !isPointInPolygon({x, bottomRight.y})) {
-                return false;
-            }
+            samples.push_back({x, topLeft.y});
+            samples.push_back({x, bottomRight.y});
         }
-
         for (T y = topLeft.y; y <= bottomRight.y; y += stepY) {
-            if (!isPointInPolygon({topLeft.x, y}) ||
-                !isPointInPolygon({bottomRight.x, y})) {
-                return false;
-            }
+            samples.push_back({topLeft.x, y});
+            samples.push_back({bottomRight.x, y});
         }
+        samples.push_back({(topLeft.x + bottomRight.x) / 2,
+                           (topLeft.y + bottomRight.y) / 2});
 
-        Point<T> center = {(topLeft.x + bottomRight.x) / 2,
-                           (topLeft.y + bottomRight.y) / 2};
-        if (!isPointInPolygon(center)) {
-            return false;
+        return allInside(samples);
+    }
+
+    [[nodiscard]] auto findMaxAreaWithPolygonConstraint() const -> T {
+        if constexpr (std::integral<T>) {
+            if (const auto polygon = CompressedPolygon<T>::build(points_)) {
+                return findMaxValidArea(
+                    [&](std::size_t i, std::size_t j) {
+                        return polygon->containsSpan(i, j);
+                    },
+                    SearchMode::Exhaustive);
+            }
         }
 
-        return true;
+        // Fallback for polygons with diagonal edges or non-integral
+        // coordinates, which the compressed grid cannot represent exactly.
+        return findLargestRectangleBySampling();
     }
 
-    [[nodiscard]] auto findMaxAreaWithPolygonConstraint() const -> T {
+    [[nodiscard]] auto findMaxValidArea(const auto& isValid,
+                                        SearchMode automatic) const -> T {
+        const SearchMode mode = mode_ == SearchMode::Auto ? automatic : mode_;
+        if (mode == SearchMode::AreaDescending) {
+            return findMaxAreaByDescendingArea(isValid);
+        }
+        return findMaxAreaExhaustive(isValid);
+    }
+
+    [[nodiscard]] auto findMaxAreaExhaustive(const auto& isValid) const -> T {
         const std::size_t n = points_.size();
         T maxArea = T{0};
 
         for (std::size_t i = 0; i < n; ++i) {
             for (std::size_t j = i + 1; j < n; ++j) {
-                Rect<T> rect(points_[i], points_[j]);
+                const T area = Rect<T>(points_[i], points_[j]).area();
 
-                if (isRectangleValid(rect)) {
-                    maxArea = std::max(maxArea, rect.area());
+                if (area > maxArea && isValid(i, j)) {
+                    maxArea = area;
                 }
             }
         }
 
         return maxArea;
     }
+
+    struct Candidate {
+        T area;
+        std::uint32_t i;
+        std::uint32_t j;
+    };
+
+    static constexpr std::size_t kFirstBatch = 1024;
+    static constexpr std::size_t kChecksPerTask = 512;
+
+    // Pulls candidates out largest-area first in geometrically growing
+    // batches; the first valid one in a batch is the answer, so usually
+    // only a sliver of the pairs is ever checked or even sorted.
+    [[nodiscard]] auto findMaxAreaByDescendingArea(const auto& isValid) const
+        -> T {
+        const std::size_t n = points_.size();
+        std::vector<Candidate> candidates;
+        candidates.reserve(n * (n - 1) / 2);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                candidates.push_back({Rect<T>(points_[i], points_[j]).area(),
+                                      static_cast<std::uint32_t>(i),
+                                      static_cast<std::uint32_t>(j)});
+            }
+        }
+
+        const auto byAreaDescending = [](const Candidate& a,
+                                         const Candidate& b) {
+            return a.area > b.area;
+        };
+
+        std::vector<std::uint8_t> valid;
+        std::size_t batch = kFirstBatch;
+
+        for (auto first = candidates.begin(); first != candidates.end();) {
+            const auto last =
+                first + static_cast<std::ptrdiff_t>(std::min<std::size_t>(
+                            batch, candidates.end() - first));
+            std::nth_element(first, last - 1, candidates.end(),
+                             byAreaDescending);
+            std::sort(first, last, byAreaDescending);
+
+            const std::span<const Candidate> slice(first, last);
+            valid.assign(slice.size(), 0);
+            checkBatch(slice, valid, isValid);
+
+            for (std::size_t k = 0; k < slice.size(); ++k) {
+                if (valid[k]) return slice[k].area;
+            }
+
+            first = last;
+            batch *= 2;
+        }
+
+        return T{0};
+    }
+
+    static auto checkBatch(std::span<const Candidate> batch,
+                           std::vector<std::uint8_t>& valid,
+                           const auto& isValid) -> void {
+        AOC::parallelFor(0, batch.size(), kChecksPerTask,
+                         [&](std::size_t begin, std::size_t end) {
+                             for (std::size_t k = begin; k < end; ++k) {
+                                 valid[k] =
+                                     isValid(batch[k].i, batch[k].j) ? 1 : 0;
+                             }
+                         });
+    }
 };
 
 template <typename Derived, Numeric T = long long>
 class SolutionStrategy {
 public:
-    explicit SolutionStrategy(const std::vector<std::string>& input)
-        : points_(PointParser<T>::parse(input)) {}
+    explicit SolutionStrategy(std::span<const Point<T>> points)
+        : points_(points) {}
 
     [[nodiscard]] auto solve() const -> T {
         return static_cast<const Derived*>(this)->solveImpl();
     }
 
-    [[nodiscard]] auto getPoints() const -> const std::vector<Point<T>>& {
+    [[nodiscard]] auto getPoints() const -> std::span<const Point<T>> {
         return points_;
     }
 
 protected:
-    std::vector<Point<T>> points_;
+    std::span<const Point<T>> points_;
 };
 
 template <Numeric T = long long>
@@ -277,32 +802,435 @@ public:
     }
 };
 
-[[nodiscard]] inline auto part1(const std::vector<std::string>& input)
-    -> long long {
-    return Part1Solution<>(input).solve();
+[[nodiscard]] inline auto part1(std::span<const Point<>> points) -> long long {
+    return Part1Solution<>(points).solve();
+}
+
+[[nodiscard]] inline auto part2(std::span<const Point<>> points) -> long long {
+    return Part2Solution<>(points).solve();
+}
+
+// Generated inputs for the differential run: a set of grid cells that is
+// connected, has no holes and has no two cells meeting only at a corner, so
+// that its outline is a simple rectilinear polygon. Grid line k lies at
+// xs[k] (or ys[k]); gaps of one leave the single-tile slits that the
+// lattice semantics must handle.
+struct Polyomino {
+    int cols = 0;
+    int rows = 0;
+    std::vector<std::uint8_t> cells;
+    std::vector<long long> xs;
+    std::vector<long long> ys;
+
+    Polyomino(const int cols_, const int rows_)
+        : cols(cols_), rows(rows_), cells(cols_ * rows_) {}
+
+    [[nodiscard]] auto filled(const int c, const int r) const -> bool {
+        return c >= 0 && r >= 0 && c < cols && r < rows &&
+               cells[r * cols + c] != 0;
+    }
+
+    auto set(const int c, const int r, const bool value) -> void {
+        cells[r * cols + c] = value ? 1 : 0;
+    }
+
+    [[nodiscard]] auto valid() const -> bool {
+        for (int r = -1; r < rows; ++r) {
+            for (int c = -1; c < cols; ++c) {
+                const bool a = filled(c, r);
+                const bool b = filled(c + 1, r);
+                if (a == filled(c + 1, r + 1) && b == filled(c, r + 1) &&
+                    a != b) {
+                    return false;
+                }
+            }
+        }
+
+        // Both the cells and the empty cells around them (one cell of
+        // padding included) must be connected; otherwise there is a hole.
+        const auto count = std::ranges::count(cells, 1);
+        return count > 0 && reachable(true) == count &&
+               reachable(false) == (cols + 2) * (rows + 2) - count;
+    }
+
+    // Outline corners, counter-clockwise.
+    [[nodiscard]] auto points() const -> std::vector<Point<>> {
+        // Unit boundary edges with the cells on their left; without
+        // corner contacts every grid point starts at most one of them.
+        std::map<std::pair<int, int>, std::pair<int, int>> next;
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                if (!filled(c, r)) continue;
+                if (!filled(c, r - 1)) next[{c, r}] = {c + 1, r};
+                if (!filled(c + 1, r)) next[{c + 1, r}] = {c + 1, r + 1};
+                if (!filled(c, r + 1)) next[{c + 1, r + 1}] = {c, r + 1};
+                if (!filled(c - 1, r)) next[{c, r + 1}] = {c, r};
+            }
+        }
+
+        std::vector<std::pair<int, int>> loop{next.begin()->first};
+        while (next.at(loop.back()) != loop.front()) {
+            loop.push_back(next.at(loop.back()));
+        }
+
+        std::vector<Point<>> corners;
+        const std::size_t n = loop.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto [pc, pr] = loop[(i + n - 1) % n];
+            const auto [nc, nr] = loop[(i + 1) % n];
+            if (pc == nc || pr == nr) continue;
+            corners.push_back({xs[loop[i].first], ys[loop[i].second]});
+        }
+        return corners;
+    }
+
+private:
+    [[nodiscard]] auto reachable(const bool value) const -> long long {
+        const int width = cols + 2;
+        std::vector<std::uint8_t> seen(width * (rows + 2));
+        std::vector<std::pair<int, int>> stack;
+
+        const auto visit = [&](const int c, const int r) {
+            if (c < -1 || r < -1 || c > cols || r > rows) return;
+            if (filled(c, r) != value) return;
+            auto& mark = seen[(r + 1) * width + c + 1];
+            if (mark) return;
+            mark = 1;
+            stack.push_back({c, r});
+        };
+
+        if (value) {
+            const auto first = std::ranges::find(cells, 1) - cells.begin();
+            visit(static_cast<int>(first % cols),
+                  static_cast<int>(first / cols));
+        } else {
+            visit(-1, -1);
+        }
+
+        long long count = 0;
+        while (!stack.empty()) {
+            const auto [c, r] = stack.back();
+            stack.pop_back();
+            ++count;
+            visit(c - 1, r);
+            visit(c + 1, r);
+            visit(c, r - 1);
+            visit(c, r + 1);
+        }
+        return count;
+    }
+};
+
+// Cells added one at a time next to the shape, kept only while it stays
+// valid: U-shapes, overhangs and other irregular outlines.
+[[nodiscard]] inline auto growBlob(std::mt19937_64& rng, const int cols,
+                                   const int rows) -> Polyomino {
+    Polyomino shape(cols, rows);
+    std::uniform_int_distribution<int> col(0, cols - 1);
+    std::uniform_int_distribution<int> row(0, rows - 1);
+    shape.set(col(rng), row(rng), true);
+
+    const int target =
+        std::uniform_int_distribution<int>(1 + cols * rows / 3,
+                                           1 + cols * rows * 2 / 3)(rng);
+    for (int added = 1, tries = 0; added < target && tries < 50 * target;
+         ++tries) {
+        const int c = col(rng);
+        const int r = row(rng);
+        if (shape.filled(c, r) ||
+            !(shape.filled(c - 1, r) || shape.filled(c + 1, r) ||
+              shape.filled(c, r - 1) || shape.filled(c, r + 1))) {
+            continue;
+        }
+
+        shape.set(c, r, true);
+        if (shape.valid()) {
+            ++added;
+        } else {
+            shape.set(c, r, false);
+        }
+    }
+    return shape;
 }
 
-[[nodiscard]] inline auto part2(const std::vector<std::string>& input)
+// A one-cell-wide square spiral whose arms are one empty cell apart.
+[[nodiscard]] inline auto traceSpiral(const int turns) -> Polyomino {
+    constexpr std::array<std::pair<int, int>, 4> kSteps{
+        {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}};
+
+    std::vector<std::pair<int, int>> path{{0, 0}};
+    for (int t = 0; t < turns; ++t) {
+        const auto [dc, dr] = kSteps[t % 4];
+        for (int step = 0; step < 2 * (t / 2 + 1); ++step) {
+            path.push_back({path.back().first + dc, path.back().second + dr});
+        }
+    }
+
+    const auto [minC, maxC] = std::ranges::minmax(path | std::views::keys);
+    const auto [minR, maxR] = std::ranges::minmax(path | std::views::values);
+    Polyomino shape(maxC - minC + 1, maxR - minR + 1);
+    for (const auto& [c, r] : path) shape.set(c - minC, r - minR, true);
+    return shape;
+}
+
+// Columns of random height on a common base: the histograms of before.
+[[nodiscard]] inline auto stackColumns(std::mt19937_64& rng, const int cols,
+                                       const int rows) -> Polyomino {
+    Polyomino shape(cols, rows);
+    std::uniform_int_distribution<int> height(1, rows);
+    for (int c = 0; c < cols; ++c) {
+        for (int r = height(rng); r-- > 0;) shape.set(c, r, true);
+    }
+    return shape;
+}
+
+// Increasing grid line coordinates; a quarter of the gaps are one tile.
+[[nodiscard]] inline auto spreadLines(std::mt19937_64& rng,
+                                      const std::size_t count,
+                                      const long long maxGap)
+    -> std::vector<long long> {
+    std::bernoulli_distribution narrow(0.25);
+    std::uniform_int_distribution<long long> gap(2, maxGap);
+
+    std::vector<long long> lines{
+        std::uniform_int_distribution<long long>(0, 5)(rng)};
+    while (lines.size() < count) {
+        lines.push_back(lines.back() + (narrow(rng) ? 1 : gap(rng)));
+    }
+    return lines;
+}
+
+// The same polygon with each axis's coordinates replaced by 2, 4, 6, ...
+// in order: no single-tile gaps and short sides, where
+// findLargestRectangleBySampling is exact.
+[[nodiscard]] inline auto evenRanks(std::vector<Point<>> points)
+    -> std::vector<Point<>> {
+    for (const auto axis : {&Point<>::x, &Point<>::y}) {
+        auto values = points | std::views::transform(axis) |
+                      std::ranges::to<std::vector>();
+        std::ranges::sort(values);
+        const auto [first, last] = std::ranges::unique(values);
+        values.erase(first, last);
+
+        for (auto& p : points) {
+            p.*axis = 2 * (std::ranges::lower_bound(values, p.*axis) -
+                           values.begin() + 1);
+        }
+    }
+    return points;
+}
+
+// Exact but slow oracle for part 2. Inside a rectilinear polygon nothing
+// changes between consecutive vertex coordinates, so a rectangle of tiles
+// fits exactly when every vertex coordinate, and one point of every gap
+// between two of them that holds a tile, is inside or on the boundary
+// within its bounds. Each of those samples is ray cast once; coordinates
+// are doubled so gap midpoints stay integral.
+[[nodiscard]] inline auto referencePart2(const std::vector<Point<>>& points)
     -> long long {
-    return Part2Solution<>(input).solve();
+    const std::size_t n = points.size();
+    if (n < 3) return 0;
+
+    const auto samples = [&](auto coordinate) {
+        std::vector<long long> values;
+        for (const auto& p : points) values.push_back(2 * coordinate(p));
+        std::ranges::sort(values);
+        const auto [first, last] = std::ranges::unique(values);
+        values.erase(first, last);
+
+        std::vector<long long> withMidpoints;
+        for (std::size_t k = 0; k < values.size(); ++k) {
+            if (k > 0 && values[k] - values[k - 1] > 2) {
+                withMidpoints.push_back((values[k - 1] + values[k]) / 2);
+            }
+            withMidpoints.push_back(values[k]);
+        }
+        return withMidpoints;
+    };
+    const auto xs = samples([](const Point<>& p) { return p.x; });
+    const auto ys = samples([](const Point<>& p) { return p.y; });
+
+    const auto covered = [&](const long long x, const long long y) {
+        bool inside = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& a = points[i];
+            const auto& b = points[(i + 1) % n];
+            const long long ax = 2 * a.x, ay = 2 * a.y;
+            const long long bx = 2 * b.x, by = 2 * b.y;
+
+            if (x >= std::min(ax, bx) && x <= std::max(ax, bx) &&
+                y >= std::min(ay, by) && y <= std::max(ay, by)) {
+                return true;
+            }
+            if (ax == bx && ax > x && std::min(ay, by) <= y &&
+                y < std::max(ay, by)) {
+                inside = !inside;
+            }
+        }
+        return inside;
+    };
+
+    std::vector<std::vector<bool>> inside(xs.size(),
+                                          std::vector<bool>(ys.size()));
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        for (std::size_t j = 0; j < ys.size(); ++j) {
+            inside[i][j] = covered(xs[i], ys[j]);
+        }
+    }
+
+    const auto index = [](const std::vector<long long>& values,
+                          const long long value) {
+        return static_cast<std::size_t>(
+            std::ranges::lower_bound(values, 2 * value) - values.begin());
+    };
+
+    long long best = 0;
+    for (std::size_t a = 0; a < n; ++a) {
+        for (std::size_t b = a + 1; b < n; ++b) {
+            const Rect<> rect(points[a], points[b]);
+            if (rect.area() <= best) continue;
+
+            const auto x0 = index(xs, std::min(points[a].x, points[b].x));
+            const auto x1 = index(xs, std::max(points[a].x, points[b].x));
+            const auto y0 = index(ys, std::min(points[a].y, points[b].y));
+            const auto y1 = index(ys, std::max(points[a].y, points[b].y));
+
+            bool fits = true;
+            for (auto i = x0; i <= x1 && fits; ++i) {
+                for (auto j = y0; j <= y1 && fits; ++j) fits = inside[i][j];
+            }
+            if (fits) best = rect.area();
+        }
+    }
+
+    return best;
+}
+
+[[nodiscard]] inline auto differentialSuite()
+    -> AOC::DifferentialSuite<Polyomino> {
+    AOC::DifferentialSuite<Polyomino> suite(
+        [](std::mt19937_64& rng, const std::size_t size) {
+            const int extent = 2 + static_cast<int>(size) / 5;
+            std::uniform_int_distribution<int> dimension(1, extent);
+
+            Polyomino shape(0, 0);
+            switch (std::uniform_int_distribution<int>(0, 2)(rng)) {
+                case 0:
+                    shape = growBlob(rng, dimension(rng), dimension(rng));
+                    break;
+                case 1:
+                    shape = traceSpiral(
+                        std::uniform_int_distribution<int>(1, extent)(rng));
+                    break;
+                default:
+                    shape = stackColumns(rng, dimension(rng), dimension(rng));
+                    break;
+            }
+
+            const auto maxGap = 2 + static_cast<long long>(size) * 10;
+            shape.xs = spreadLines(rng, shape.cols + 1, maxGap);
+            shape.ys = spreadLines(rng, shape.rows + 1, maxGap);
+            return shape;
+        },
+        [](const Polyomino& shape) {
+            std::vector<Polyomino> smaller;
+            for (std::size_t k = 0; k < shape.cells.size(); ++k) {
+                if (!shape.cells[k]) continue;
+                auto without = shape;
+                without.cells[k] = 0;
+                if (without.valid()) smaller.push_back(std::move(without));
+            }
+
+            // Halving a gap moves every later line with it.
+            for (const auto lines : {&Polyomino::xs, &Polyomino::ys}) {
+                const auto& coords = shape.*lines;
+                for (std::size_t k = 1; k < coords.size(); ++k) {
+                    const long long cut = (coords[k] - coords[k - 1]) / 2;
+                    if (cut == 0) continue;
+                    auto closer = shape;
+                    for (auto i = k; i < coords.size(); ++i) {
+                        (closer.*lines)[i] -= cut;
+                    }
+                    smaller.push_back(std::move(closer));
+                }
+            }
+            return smaller;
+        },
+        [](const Polyomino& shape) {
+            std::string text;
+            for (const auto& [x, y] : shape.points()) {
+                text += std::format("{},{}\n", x, y);
+            }
+            text.pop_back();
+            return text;
+        });
+
+    const auto inside = [](const SearchMode mode) {
+        return [mode](const Polyomino& shape) {
+            return RectangleFinder<>(shape.points(), mode)
+                .findLargestRectangleInsidePolygon();
+        };
+    };
+
+    suite.add(
+        "part1",
+        [](const Polyomino& shape) {
+            return RectangleFinder<>(shape.points(), SearchMode::Exhaustive)
+                .findLargestRectangle();
+        },
+        [](const Polyomino& shape) { return part1(shape.points()); });
+    suite.add(
+        "part2",
+        [](const Polyomino& shape) { return referencePart2(shape.points()); },
+        [](const Polyomino& shape) { return part2(shape.points()); });
+    suite.add(
+        "part2 exhaustive",
+        [](const Polyomino& shape) { return referencePart2(shape.points()); },
+        inside(SearchMode::Exhaustive));
+    suite.add(
+        "part2 area-descending",
+        [](const Polyomino& shape) { return referencePart2(shape.points()); },
+        inside(SearchMode::AreaDescending));
+    suite.add(
+        "part2 sampled",
+        [](const Polyomino& shape) {
+            return referencePart2(evenRanks(shape.points()));
+        },
+        [](const Polyomino& shape) {
+            return RectangleFinder<>(evenRanks(shape.points()))
+                .findLargestRectangleBySampling();
+        });
+    return suite;
 }
 
-int main() {
+// Bump whenever Point or PointParser changes, so stale snapshots are
+// ignored.
+inline constexpr std::uint32_t kSnapshotVersion = 1;
+
+int main(int argc, char* argv[]) {
     try {
-        std::vector<std::string> input = AOC::fetchAOCInputVector(2025, 9);
+        if (const auto options =
+                AOC::DifferentialOptions::fromArgs(argc, argv)) {
+            return differentialSuite().run(*options);
+        }
 
-        std::string part1_ans = std::to_string(part1(input));
-        std::string part2_ans = std::to_string(part2(input));
+        AOC::Runner runner(2025, 9, argc, argv, AOC::embeddedInput());
+        if (runner.skipped()) return AOC::Runner::kSkipped;
+        const std::string input = runner.rawInput();
+        const auto points = runner.phase("parse", [&] {
+            return AOC::loadOrParse<Point<>>(
+                runner.snapshotPath("points"), kSnapshotVersion, input,
+                [&] { return PointParser<>::parse(AOC::splitLines(input)); });
+        });
 
-        std::println("Part 1 ans : {}", part1_ans);
-        std::println("Part 2 ans : {}", part2_ans);
+        runner.answer(1, runner.phase("part1",
+                                      [&] { return part1(points.view()); }));
+        runner.answer(2, runner.phase("part2",
+                                      [&] { return part2(points.view()); }));
 
-        AOC::submitAnswer(2025, 9, 1, part1_ans);
-        AOC::submitAnswer(2025, 9, 2, part2_ans);
+        return runner.finish();
     } catch (const std::exception& e) {
         std::cerr << "Error fetching input: " << e.what() << "\n";
         return 1;
     }
-
-    return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,56 @@
+#include <charconv>
+#include <iostream>
+#include <print>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "Prefetch.hpp"
+
+namespace {
+    int parseNumber(const std::string_view text) {
+        int value = 0;
+        const auto [end, error] =
+            std::from_chars(text.data(), text.data() + text.size(), value);
+        if (error != std::errc{} || end != text.data() + text.size()) {
+            throw std::invalid_argument(
+                std::format("not a number: '{}'", text));
+        }
+        return value;
+    }
+}  // namespace
+
+// prefetch <year> <day>...: downloads every missing input in one go.
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) {
+            std::cerr << "usage: " << argv[0] << " <year> <day>...\n";
+            return 2;
+        }
+
+        const int year = parseNumber(argv[1]);
+        std::vector<int> days;
+        for (int i = 2; i < argc; ++i) days.push_back(parseNumber(argv[i]));
+
+        bool failed = false;
+        for (const auto& [day, status, error] : AOC::prefetch(year, days)) {
+            switch (status) {
+                case AOC::PrefetchResult::Status::Cached:
+                    std::println("{:02}/{}: cached", day, year);
+                    break;
+                case AOC::PrefetchResult::Status::Fetched:
+                    std::println("{:02}/{}: fetched", day, year);
+                    break;
+                case AOC::PrefetchResult::Status::Failed:
+                    std::println("{:02}/{}: FAILED ({})", day, year, error);
+                    failed = true;
+                    break;
+            }
+        }
+
+        return failed ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error prefetching inputs: " << e.what() << "\n";
+        return 1;
+    }
+}